@@ -3,7 +3,11 @@
 #define STRUCTURES_ARRAY_LIST_H
 
 #include <cstdint>
+#include <cstring>
+#include <new>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 namespace structures {
 
@@ -22,16 +26,18 @@ class ArrayList {
 
     /*!
     * Inicializa a lista sem elementos de tamanho "max_size"
+    * Se "growable" for verdadeiro, a capacidade dobra sempre que a lista
+    * enche, em vez de lançar exceção
     */
-    explicit ArrayList(std::size_t max_size);
+    explicit ArrayList(std::size_t max_size, bool growable = false);
 
     /*!
-    * Deleta o array dos elementos também
+    * Destrói os elementos e libera a memória do array
     */
     ~ArrayList();
 
     /*!
-    * limpa a lista atribuindo 0 ao "size_"
+    * destrói todos os elementos e atribui 0 ao "size_"
     */
     void clear();
 
@@ -40,6 +46,28 @@ class ArrayList {
     */
     void push_back(const T& data);
 
+    /*!
+    * Adiciona "data" ao final da lista, movendo-o
+    */
+    void push_back(T&& data);
+
+    /*!
+    * Constrói um elemento ao final da lista a partir de "args"
+    * retorna o elemento construído
+    */
+    template<typename... Args>
+    T& emplace_back(Args&&... args);
+
+    /*!
+    * Garante capacidade para ao menos "capacity" elementos
+    */
+    void reserve(std::size_t capacity);
+
+    /*!
+    * Reduz a capacidade ao tamanho atual da lista
+    */
+    void shrink_to_fit();
+
     /*!
     * Move todos os elementos um slot acima
     * Insere "data" ao começo da lista
@@ -108,6 +136,11 @@ class ArrayList {
     */
     std::size_t max_size() const;
 
+    /*!
+    * retorna se a lista cresce automaticamente quando cheia
+    */
+    bool growable() const;
+
     /*!
     * verifica se index está fora dos limites
     * retorna elemento na posição "index"
@@ -131,9 +164,43 @@ class ArrayList {
     const T& operator[](std::size_t index) const;
 
  private:
+    /*!
+    * Garante espaço para mais um elemento, dobrando a capacidade se a lista
+    * for "growable_", ou lança exceção se estiver cheia
+    */
+    void ensure_room();
+
+    /*!
+    * Capacidade usada ao dobrar a lista cheia
+    */
+    std::size_t grown_capacity() const;
+
+    /*!
+    * Realoca os elementos para um novo array de tamanho "capacity"
+    */
+    void relocate(std::size_t capacity);
+
+    /*!
+    * Constrói os elementos atuais em "new_contents" e só então destrói os
+    * antigos. Usa memcpy quando T é trivialmente copiável e move nos demais
+    * casos; se uma cópia lançar exceção, a lista fica intacta
+    */
+    void transfer(T* new_contents);
+
+    /*!
+    * Libera o array atual e passa a usar "new_contents"
+    */
+    void adopt(T* new_contents, std::size_t capacity);
+
+    /*!
+    * Aloca memória não inicializada para "capacity" elementos
+    */
+    static T* allocate(std::size_t capacity);
+
     T* contents;
     std::size_t size_ = 0;
     std::size_t max_size_;
+    bool growable_;
 
     static const auto DEFAULT_MAX = 10u;
 };  // ArrayList
@@ -142,52 +209,100 @@ template<typename T>
 ArrayList<T>::ArrayList() : ArrayList(DEFAULT_MAX) {}
 
 template<typename T>
-ArrayList<T>::ArrayList(std::size_t max_size):
-    contents {new T[max_size]},
-    max_size_ {max_size} {}
+ArrayList<T>::ArrayList(std::size_t max_size, bool growable):
+    contents {allocate(max_size)},
+    max_size_ {max_size},
+    growable_ {growable} {}
 
 template<typename T>
 ArrayList<T>::~ArrayList() {
-    delete[] contents;
+    clear();
+    ::operator delete(contents);
 }
 
 template<typename T>
 void ArrayList<T>::clear() {
+    for (std::size_t position = 0; position < size_; position++)
+        contents[position].~T();
     size_ = 0;
 }
 
 template<typename T>
 void ArrayList<T>::push_back(const T& data) {
-    if (full())
+    emplace_back(data);
+}
+
+template<typename T>
+void ArrayList<T>::push_back(T&& data) {
+    emplace_back(std::move(data));
+}
+
+template<typename T>
+template<typename... Args>
+T& ArrayList<T>::emplace_back(Args&&... args) {
+    if (!full()) {
+        new (contents + size_) T(std::forward<Args>(args)...);
+        return contents[size_++];
+    }
+    if (!growable_)
         throw std::out_of_range("List is full!");
-    contents[size_++] = data;
+    // "args" pode referenciar um elemento deste array: o novo elemento é
+    // construído antes de os antigos serem movidos
+    std::size_t capacity = grown_capacity();
+    T* new_contents = allocate(capacity);
+    try {
+        new (new_contents + size_) T(std::forward<Args>(args)...);
+    } catch (...) {
+        ::operator delete(new_contents);
+        throw;
+    }
+    try {
+        transfer(new_contents);
+    } catch (...) {
+        new_contents[size_].~T();
+        ::operator delete(new_contents);
+        throw;
+    }
+    adopt(new_contents, capacity);
+    return contents[size_++];
+}
+
+template<typename T>
+void ArrayList<T>::reserve(std::size_t capacity) {
+    if (capacity > max_size_)
+        relocate(capacity);
+}
+
+template<typename T>
+void ArrayList<T>::shrink_to_fit() {
+    if (size_ < max_size_)
+        relocate(size_);
 }
 
 template<typename T>
 void ArrayList<T>::push_front(const T& data) {
-    if (full())
-        throw std::out_of_range("List is full!");
-    size_++;
-    for (std::size_t position = size_-1; position > 0; position--)
-        contents[position] = contents[position-1];
-    contents[0] = data;
+    insert(data, 0);
 }
 
 template<typename T>
 void ArrayList<T>::insert(const T& data, std::size_t index) {
-    if (full())
-        throw std::out_of_range("List is full!");
-    if ((index < 0 || index >= size_) && (empty() && index != 0))
+    if (index > size_)
         throw std::out_of_range("Index invalid!");
-    for (std::size_t position = size_; position > index; position--)
-        contents[position] = contents[position-1];
-    contents[index] = data;
+    T copy(data);  // "data" pode apontar para dentro do array realocado
+    ensure_room();
+    if (index == size_) {
+        new (contents + size_) T(std::move(copy));
+    } else {
+        new (contents + size_) T(std::move(contents[size_-1]));
+        for (std::size_t position = size_-1; position > index; position--)
+            contents[position] = std::move(contents[position-1]);
+        contents[index] = std::move(copy);
+    }
     size_++;
 }
+
 template<typename T>
 void ArrayList<T>::insert_sorted(const T& data) {
-    if (full())
-        throw std::out_of_range("List is full!");
     std::size_t position = 0;
     while (position < size_ && data > contents[position])
         position++;
@@ -198,12 +313,13 @@ template<typename T>
 T ArrayList<T>::pop(std::size_t index) {
     if (empty())
         throw std::out_of_range("List is empty!");
-    if (index < 0 || index >= size_)
-        throw std::out_of_range("List is empty!");
-    auto data = contents[index];
+    if (index >= size_)
+        throw std::out_of_range("Index invalid!");
+    T data(std::move(contents[index]));
     size_--;
     for (std::size_t position = index; position < size_; position++)
-        contents[position] = contents[position+1];
+        contents[position] = std::move(contents[position+1]);
+    contents[size_].~T();
     return data;
 }
 
@@ -211,7 +327,9 @@ template<typename T>
 T ArrayList<T>::pop_back() {
     if (empty())
         throw std::out_of_range("List is empty!");
-    return contents[--size_];
+    T data(std::move(contents[--size_]));
+    contents[size_].~T();
+    return data;
 }
 
 template<typename T>
@@ -260,6 +378,11 @@ std::size_t ArrayList<T>::max_size() const {
     return max_size_;
 }
 
+template<typename T>
+bool ArrayList<T>::growable() const {
+    return growable_;
+}
+
 template<typename T>
 T& ArrayList<T>::at(std::size_t index) {
     if (index < 0 || index >= size_)
@@ -282,6 +405,66 @@ const T& ArrayList<T>::operator[](std::size_t index) const {
     return operator[](index);
 }
 
+template<typename T>
+void ArrayList<T>::ensure_room() {
+    if (!full())
+        return;
+    if (!growable_)
+        throw std::out_of_range("List is full!");
+    relocate(grown_capacity());
+}
+
+template<typename T>
+std::size_t ArrayList<T>::grown_capacity() const {
+    return max_size_ == 0 ? DEFAULT_MAX : max_size_ * 2;
+}
+
+template<typename T>
+void ArrayList<T>::relocate(std::size_t capacity) {
+    T* new_contents = allocate(capacity);
+    try {
+        transfer(new_contents);
+    } catch (...) {
+        ::operator delete(new_contents);
+        throw;
+    }
+    adopt(new_contents, capacity);
+}
+
+template<typename T>
+void ArrayList<T>::transfer(T* new_contents) {
+    if (std::is_trivially_copyable<T>::value) {
+        if (size_ > 0)
+            std::memcpy(static_cast<void*>(new_contents), contents,
+                        size_ * sizeof(T));
+        return;
+    }
+    std::size_t built = 0;
+    try {
+        for (; built < size_; built++)
+            new (new_contents + built) T(std::move_if_noexcept(
+                contents[built]));
+    } catch (...) {
+        while (built > 0)
+            new_contents[--built].~T();
+        throw;
+    }
+    for (std::size_t position = 0; position < size_; position++)
+        contents[position].~T();
+}
+
+template<typename T>
+void ArrayList<T>::adopt(T* new_contents, std::size_t capacity) {
+    ::operator delete(contents);
+    contents = new_contents;
+    max_size_ = capacity;
+}
+
+template<typename T>
+T* ArrayList<T>::allocate(std::size_t capacity) {
+    return static_cast<T*>(::operator new(capacity * sizeof(T)));
+}
+
 }  // namespace structures
 
 #endif
@@ -2,6 +2,7 @@
 #ifndef STRUCTURES_ARRAY_QUEUE_H
 #define STRUCTURES_ARRAY_QUEUE_H
 
+#include <algorithm>  // std::copy
 #include <cstdint>  // std::size_t
 #include <stdexcept>  // C++ Exceptions
 
@@ -9,6 +10,8 @@ namespace structures {
 
 template<typename T>
 //! classe ArrayQueue
+//! fila circular: o array tem capacidade potência de 2 e os índices são
+//! calculados com máscara, de modo que enqueue e dequeue são O(1)
 class ArrayQueue {
  public:
     //! construtor padrao
@@ -19,8 +22,14 @@ class ArrayQueue {
     ~ArrayQueue();
     //! metodo enfileirar
     void enqueue(const T& data);
+    //! metodo enfileirar n elementos de "data" de uma vez
+    void enqueue_n(const T* data, std::size_t n);
     //! metodo desenfileirar
     T dequeue();
+    //! metodo desenfileirar n elementos de uma vez, copiando-os para "out"
+    void dequeue_n(T* out, std::size_t n);
+    //! metodo retorna o primeiro
+    T& front();
     //! metodo retorna o ultimo
     T& back();
     //! metodo limpa a fila
@@ -35,11 +44,14 @@ class ArrayQueue {
     bool full();
 
  private:
+    //! menor potência de 2 maior ou igual a "n"
+    static std::size_t next_power_of_two(std::size_t n);
+
     T* contents;
     std::size_t size_;
     std::size_t max_size_;
-    int begin_;  // indice do inicio (para fila circular)
-    int end_;  // indice do fim (para fila circular)
+    std::size_t mask_;  // capacidade do array - 1
+    std::size_t begin_;  // indice do inicio (para fila circular)
     static const auto DEFAULT_SIZE = 10u;
 };
 
@@ -50,18 +62,17 @@ class ArrayQueue {
 //-----------------------------------------------------------------------------
 
 template <typename T>
-structures::ArrayQueue<T>::ArrayQueue() {
-    contents = new T[DEFAULT_SIZE];
-    begin_ = 0;
-    end_ =-1;
-}
+structures::ArrayQueue<T>::ArrayQueue() :
+    ArrayQueue(DEFAULT_SIZE) {}
 
 template<typename T>
 structures::ArrayQueue<T>::ArrayQueue(std::size_t max) {
+    std::size_t capacity = next_power_of_two(max);
     max_size_ = max;
-    contents = new T[max_size_];
+    mask_ = capacity - 1;
+    contents = new T[capacity];
+    size_ = 0;
     begin_ = 0;
-    end_= -1;
 }
 
 template<typename T>
@@ -73,38 +84,67 @@ template<typename T>
 void structures::ArrayQueue<T>::enqueue(const T& data) {
     if (full())
         throw std::out_of_range("FullQueue");
-    end_++;
-    contents[end_] = data;
+    contents[(begin_ + size_) & mask_] = data;
+    size_++;
+}
+
+template<typename T>
+void structures::ArrayQueue<T>::enqueue_n(const T* data, std::size_t n) {
+    if (n > max_size_ - size_)
+        throw std::out_of_range("FullQueue");
+    // copia em no máximo dois trechos contíguos: até o fim do array
+    // e, se necessário, a partir do início
+    std::size_t end = (begin_ + size_) & mask_;
+    std::size_t first = std::min(n, mask_ + 1 - end);
+    std::copy(data, data + first, contents + end);
+    std::copy(data + first, data + n, contents);
+    size_ += n;
 }
 
 template<typename T>
 T structures::ArrayQueue<T>::dequeue() {
     if (empty())
         throw std::out_of_range("EmptyQueue");
-    T aux;
-    aux = contents[0];
-    for (int i = 1; i <= end_ ; i ++) {
-        contents[i-1] = contents[i];
-    }
-    end_--;
+    T aux = contents[begin_];
+    begin_ = (begin_ + 1) & mask_;
+    size_--;
     return aux;
 }
 
+template<typename T>
+void structures::ArrayQueue<T>::dequeue_n(T* out, std::size_t n) {
+    if (n > size_)
+        throw std::out_of_range("EmptyQueue");
+    std::size_t first = std::min(n, mask_ + 1 - begin_);
+    std::copy(contents + begin_, contents + begin_ + first, out);
+    std::copy(contents, contents + (n - first), out + first);
+    begin_ = (begin_ + n) & mask_;
+    size_ -= n;
+}
+
+template<typename T>
+T& structures::ArrayQueue<T>::front() {
+    if (empty())
+        throw std::out_of_range("EmptyQueue");
+    return contents[begin_];
+}
+
 template<typename T>
 T& structures::ArrayQueue<T>::back() {
     if (empty())
         throw std::out_of_range("EmptyQueue");
-    return contents[end_];
+    return contents[(begin_ + size_ - 1) & mask_];
 }
 
 template<typename T>
 void structures::ArrayQueue<T>::clear() {
-    end_= -1;
+    size_ = 0;
+    begin_ = 0;
 }
 
 template<typename T>
 std::size_t structures::ArrayQueue<T>::size() {
-    return end_ + 1;
+    return size_;
 }
 
 template<typename T>
@@ -114,10 +154,18 @@ std::size_t structures::ArrayQueue<T>::max_size() {
 
 template<typename T>
 bool structures::ArrayQueue<T>::empty() {
-    return (end_ == -1);
+    return size_ == 0;
 }
 
 template<typename T>
 bool structures::ArrayQueue<T>::full() {
-    return (end_ == static_cast<int>(max_size()-1));
+    return size_ == max_size_;
+}
+
+template<typename T>
+std::size_t structures::ArrayQueue<T>::next_power_of_two(std::size_t n) {
+    std::size_t capacity = 1;
+    while (capacity < n)
+        capacity <<= 1;
+    return capacity;
 }
@@ -0,0 +1,136 @@
+// Copyright [2021] <Gabriel da Silva Cardoso>
+// Vazão das filas concorrentes comparadas com uma ArrayQueue protegida por
+// mutex. Compilar com: g++ -std=c++17 -O2 -pthread bench.cpp -o bench
+// Uso: ./bench [operacoes]  (padrão 2^22 pares enqueue/dequeue)
+// As esperas por espaço ou por elementos cedem o núcleo (yield), então os
+// números com mais threads que núcleos medem a disputa, não o paralelismo.
+
+#include <chrono>  // std::chrono
+#include <cstdio>  // std::printf
+#include <cstdlib>  // std::strtoull
+#include <mutex>  // std::mutex
+#include <thread>  // std::thread
+#include <vector>  // std::vector
+
+#include "array_queue.h"
+#include "mpmc_array_queue.h"
+#include "spsc_array_queue.h"
+
+namespace {
+
+const std::size_t CAPACITY = 1024;
+
+//! ArrayQueue com um mutex em volta de cada operação, como era preciso
+//! fazer antes das filas sem travas
+template<typename T>
+class LockedArrayQueue {
+ public:
+    explicit LockedArrayQueue(std::size_t max) : queue_(max) {}
+
+    bool try_enqueue(const T& data) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (queue_.full())
+            return false;
+        queue_.enqueue(data);
+        return true;
+    }
+
+    bool try_dequeue(T& data) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (queue_.empty())
+            return false;
+        data = queue_.dequeue();
+        return true;
+    }
+
+ private:
+    std::mutex mutex_;
+    structures::ArrayQueue<T> queue_;
+};
+
+//! roda "body(thread)" em "threads" threads e retorna os segundos gastos
+template<typename Body>
+double run(unsigned threads, Body body) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < threads; t++)
+        pool.emplace_back(body, t);
+    for (std::thread& thread : pool)
+        thread.join();
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+//! cada thread enfileira e desenfileira "operations / threads" vezes;
+//! retorna milhões de pares por segundo
+template<typename Queue>
+double pairs(unsigned threads, std::size_t operations) {
+    Queue queue(CAPACITY);
+    std::size_t per_thread = operations / threads;
+    double seconds = run(threads, [&](unsigned t) {
+        for (std::size_t i = 0; i < per_thread; i++) {
+            std::size_t data = t + i;
+            while (!queue.try_enqueue(data))
+                std::this_thread::yield();
+            // outra thread pode estar no meio de um enqueue
+            while (!queue.try_dequeue(data))
+                std::this_thread::yield();
+        }
+    });
+    return per_thread * threads / seconds / 1e6;
+}
+
+//! uma thread produtora e uma consumidora; retorna milhões de elementos
+//! por segundo
+template<typename Queue>
+double producer_consumer(std::size_t operations) {
+    Queue queue(CAPACITY);
+    std::size_t sum = 0;
+    double seconds = run(2, [&](unsigned t) {
+        if (t == 0) {
+            for (std::size_t i = 0; i < operations; i++)
+                while (!queue.try_enqueue(i))
+                    std::this_thread::yield();
+        } else {
+            std::size_t data;
+            for (std::size_t i = 0; i < operations; i++) {
+                while (!queue.try_dequeue(data))
+                    std::this_thread::yield();
+                sum += data;
+            }
+        }
+    });
+    if (sum != operations * (operations - 1) / 2)
+        std::printf("erro: elementos perdidos\n");
+    return operations / seconds / 1e6;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::size_t operations = argc > 1 ? std::strtoull(argv[1], nullptr, 10)
+                                      : std::size_t{1} << 22;
+
+    std::printf("pares enqueue/dequeue por thread (Mops/s)\n");
+    std::printf("%8s %12s %12s\n", "threads", "mutex", "mpmc");
+    for (unsigned threads : {1u, 2u, 4u, 8u, 16u}) {
+        std::printf("%8u %12.2f %12.2f\n", threads,
+                    pairs<LockedArrayQueue<std::size_t>>(threads, operations),
+                    pairs<structures::MpmcArrayQueue<std::size_t>>(threads,
+                                                                   operations));
+    }
+
+    std::printf("\n1 produtor, 1 consumidor (Mops/s)\n");
+    std::printf("%12s %12s %12s\n", "mutex", "mpmc", "spsc");
+    std::printf("%12.2f %12.2f %12.2f\n",
+                producer_consumer<LockedArrayQueue<std::size_t>>(operations),
+                producer_consumer<structures::MpmcArrayQueue<std::size_t>>(
+                    operations),
+                producer_consumer<structures::SpscArrayQueue<std::size_t>>(
+                    operations));
+
+    std::printf("\nnúcleos disponíveis: %u\n",
+                std::thread::hardware_concurrency());
+    return 0;
+}
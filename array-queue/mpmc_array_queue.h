@@ -0,0 +1,194 @@
+// Copyright [2021] <Gabriel da Silva Cardoso>
+#ifndef STRUCTURES_MPMC_ARRAY_QUEUE_H
+#define STRUCTURES_MPMC_ARRAY_QUEUE_H
+
+#include <atomic>  // std::atomic
+#include <cstdint>  // std::size_t
+#include <stdexcept>  // C++ Exceptions
+
+namespace structures {
+
+template<typename T>
+//! classe MpmcArrayQueue
+//! fila circular limitada sem travas para varios produtores e varios
+//! consumidores (algoritmo de Vyukov). Cada posicao guarda um numero de
+//! sequencia que indica se ela esta livre para escrita ou pronta para
+//! leitura na volta atual do indice. O array e arredondado para a
+//! proxima potencia de 2, mas a fila guarda no maximo "max" elementos,
+//! como ArrayQueue e SpscArrayQueue
+class MpmcArrayQueue {
+ public:
+    //! construtor padrao
+    MpmcArrayQueue();
+    //! construtor com parametro
+    explicit MpmcArrayQueue(std::size_t max);
+    //! destrutor padrao
+    ~MpmcArrayQueue();
+    //! metodo enfileirar
+    void enqueue(const T& data);
+    //! metodo tenta enfileirar, retorna false se estiver cheia
+    bool try_enqueue(const T& data);
+    //! metodo desenfileirar
+    T dequeue();
+    //! metodo tenta desenfileirar em "data", retorna false se estiver vazia
+    bool try_dequeue(T& data);
+    //! metodo retorna tamanho atual (aproximado se houver concorrencia)
+    std::size_t size() const;
+    //! metodo retorna tamanho maximo
+    std::size_t max_size() const;
+    //! metodo verifica se vazio
+    bool empty() const;
+    //! metodo verifica se esta cheio
+    bool full() const;
+
+ private:
+    static const std::size_t CACHE_LINE = 64;
+
+    //! posicao da fila: dado e numero de sequencia
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        T data;
+    };
+
+    Cell* contents;
+    std::size_t max_size_;
+    std::size_t mask_;  // capacidade do array - 1
+
+    // proxima posicao a ser lida, disputada entre consumidores
+    alignas(CACHE_LINE) std::atomic<std::size_t> head_{0};
+    // proxima posicao a ser escrita, disputada entre produtores
+    alignas(CACHE_LINE) std::atomic<std::size_t> tail_{0};
+
+    static const auto DEFAULT_SIZE = 16u;
+};
+
+}  // namespace structures
+
+#endif
+
+//-----------------------------------------------------------------------------
+
+template<typename T>
+structures::MpmcArrayQueue<T>::MpmcArrayQueue() :
+    MpmcArrayQueue(DEFAULT_SIZE) {}
+
+template<typename T>
+structures::MpmcArrayQueue<T>::MpmcArrayQueue(std::size_t max) {
+    // o algoritmo precisa de ao menos duas posicoes
+    std::size_t capacity = 2;
+    while (capacity < max)
+        capacity <<= 1;
+    max_size_ = max;
+    mask_ = capacity - 1;
+    contents = new Cell[capacity];
+    for (std::size_t i = 0; i < capacity; i++)
+        contents[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+template<typename T>
+structures::MpmcArrayQueue<T>::~MpmcArrayQueue() {
+    delete [] contents;
+}
+
+template<typename T>
+void structures::MpmcArrayQueue<T>::enqueue(const T& data) {
+    if (!try_enqueue(data))
+        throw std::out_of_range("FullQueue");
+}
+
+template<typename T>
+bool structures::MpmcArrayQueue<T>::try_enqueue(const T& data) {
+    std::size_t tail = tail_.load(std::memory_order_relaxed);
+    Cell* cell;
+
+    while (true) {
+        cell = &contents[tail & mask_];
+        std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<std::intptr_t>(sequence)
+                  - static_cast<std::intptr_t>(tail);
+
+        if (diff == 0) {
+            // com o array maior que o maximo pedido, a posicao livre nao
+            // basta: o head lido pode estar atrasado, o que so faz a fila
+            // parecer mais cheia, nunca passar do maximo
+            if (max_size_ <= mask_ &&
+                tail - head_.load(std::memory_order_acquire) >= max_size_)
+                return false;
+            // posicao livre nesta volta: tenta reserva-la
+            if (tail_.compare_exchange_weak(tail, tail + 1,
+                                            std::memory_order_relaxed))
+                break;
+        } else if (diff < 0) {
+            // posicao ainda ocupada pela volta anterior: fila cheia
+            return false;
+        } else {
+            // outro produtor ja reservou a posicao
+            tail = tail_.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->data = data;
+    cell->sequence.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T>
+T structures::MpmcArrayQueue<T>::dequeue() {
+    T data;
+    if (!try_dequeue(data))
+        throw std::out_of_range("EmptyQueue");
+    return data;
+}
+
+template<typename T>
+bool structures::MpmcArrayQueue<T>::try_dequeue(T& data) {
+    std::size_t head = head_.load(std::memory_order_relaxed);
+    Cell* cell;
+
+    while (true) {
+        cell = &contents[head & mask_];
+        std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<std::intptr_t>(sequence)
+                  - static_cast<std::intptr_t>(head + 1);
+
+        if (diff == 0) {
+            // posicao preenchida nesta volta: tenta reserva-la
+            if (head_.compare_exchange_weak(head, head + 1,
+                                            std::memory_order_relaxed))
+                break;
+        } else if (diff < 0) {
+            // nenhum produtor escreveu aqui ainda: fila vazia
+            return false;
+        } else {
+            // outro consumidor ja reservou a posicao
+            head = head_.load(std::memory_order_relaxed);
+        }
+    }
+
+    data = cell->data;
+    // libera a posicao para o produtor da proxima volta
+    cell->sequence.store(head + mask_ + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T>
+std::size_t structures::MpmcArrayQueue<T>::size() const {
+    std::size_t head = head_.load(std::memory_order_acquire);
+    std::size_t tail = tail_.load(std::memory_order_acquire);
+    return tail > head ? tail - head : 0;
+}
+
+template<typename T>
+std::size_t structures::MpmcArrayQueue<T>::max_size() const {
+    return max_size_;
+}
+
+template<typename T>
+bool structures::MpmcArrayQueue<T>::empty() const {
+    return size() == 0;
+}
+
+template<typename T>
+bool structures::MpmcArrayQueue<T>::full() const {
+    return size() >= max_size_;
+}
@@ -0,0 +1,147 @@
+// Copyright [2021] <Gabriel da Silva Cardoso>
+#ifndef STRUCTURES_SPSC_ARRAY_QUEUE_H
+#define STRUCTURES_SPSC_ARRAY_QUEUE_H
+
+#include <atomic>  // std::atomic
+#include <cstdint>  // std::size_t
+#include <stdexcept>  // C++ Exceptions
+
+namespace structures {
+
+template<typename T>
+//! classe SpscArrayQueue
+//! fila circular sem travas para exatamente uma thread produtora e uma
+//! thread consumidora. Cada lado só escreve no seu próprio índice e lê o
+//! do outro com acquire, publicando o próprio com release
+class SpscArrayQueue {
+ public:
+    //! construtor padrao
+    SpscArrayQueue();
+    //! construtor com parametro
+    explicit SpscArrayQueue(std::size_t max);
+    //! destrutor padrao
+    ~SpscArrayQueue();
+    //! metodo enfileirar (somente produtor)
+    void enqueue(const T& data);
+    //! metodo tenta enfileirar, retorna false se estiver cheia
+    bool try_enqueue(const T& data);
+    //! metodo desenfileirar (somente consumidor)
+    T dequeue();
+    //! metodo tenta desenfileirar em "data", retorna false se estiver vazia
+    bool try_dequeue(T& data);
+    //! metodo retorna tamanho atual (aproximado se houver concorrencia)
+    std::size_t size() const;
+    //! metodo retorna tamanho maximo
+    std::size_t max_size() const;
+    //! metodo verifica se vazio
+    bool empty() const;
+    //! metodo verifica se esta cheio
+    bool full() const;
+
+ private:
+    static const std::size_t CACHE_LINE = 64;
+
+    T* contents;
+    std::size_t max_size_;
+    std::size_t mask_;  // capacidade do array - 1
+
+    // indice de leitura, escrito apenas pelo consumidor
+    alignas(CACHE_LINE) std::atomic<std::size_t> head_{0};
+    // copia local do tail_ vista pelo consumidor
+    std::size_t tail_cache_{0};
+
+    // indice de escrita, escrito apenas pelo produtor
+    alignas(CACHE_LINE) std::atomic<std::size_t> tail_{0};
+    // copia local do head_ vista pelo produtor
+    std::size_t head_cache_{0};
+
+    static const auto DEFAULT_SIZE = 10u;
+};
+
+}  // namespace structures
+
+#endif
+
+//-----------------------------------------------------------------------------
+
+template<typename T>
+structures::SpscArrayQueue<T>::SpscArrayQueue() :
+    SpscArrayQueue(DEFAULT_SIZE) {}
+
+template<typename T>
+structures::SpscArrayQueue<T>::SpscArrayQueue(std::size_t max) {
+    std::size_t capacity = 1;
+    while (capacity < max)
+        capacity <<= 1;
+    max_size_ = max;
+    mask_ = capacity - 1;
+    contents = new T[capacity];
+}
+
+template<typename T>
+structures::SpscArrayQueue<T>::~SpscArrayQueue() {
+    delete [] contents;
+}
+
+template<typename T>
+void structures::SpscArrayQueue<T>::enqueue(const T& data) {
+    if (!try_enqueue(data))
+        throw std::out_of_range("FullQueue");
+}
+
+template<typename T>
+bool structures::SpscArrayQueue<T>::try_enqueue(const T& data) {
+    std::size_t tail = tail_.load(std::memory_order_relaxed);
+    // so relê o head_ compartilhado quando a copia local indica fila cheia
+    if (tail - head_cache_ == max_size_) {
+        head_cache_ = head_.load(std::memory_order_acquire);
+        if (tail - head_cache_ == max_size_)
+            return false;
+    }
+    contents[tail & mask_] = data;
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T>
+T structures::SpscArrayQueue<T>::dequeue() {
+    T data;
+    if (!try_dequeue(data))
+        throw std::out_of_range("EmptyQueue");
+    return data;
+}
+
+template<typename T>
+bool structures::SpscArrayQueue<T>::try_dequeue(T& data) {
+    std::size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_cache_) {
+        tail_cache_ = tail_.load(std::memory_order_acquire);
+        if (head == tail_cache_)
+            return false;
+    }
+    data = contents[head & mask_];
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T>
+std::size_t structures::SpscArrayQueue<T>::size() const {
+    std::size_t head = head_.load(std::memory_order_acquire);
+    std::size_t tail = tail_.load(std::memory_order_acquire);
+    return tail - head;
+}
+
+template<typename T>
+std::size_t structures::SpscArrayQueue<T>::max_size() const {
+    return max_size_;
+}
+
+template<typename T>
+bool structures::SpscArrayQueue<T>::empty() const {
+    return size() == 0;
+}
+
+template<typename T>
+bool structures::SpscArrayQueue<T>::full() const {
+    return size() >= max_size_;
+}
@@ -0,0 +1,301 @@
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../concurrent_trie.hpp"
+#include "../loader.hpp"
+#include "../query_io.hpp"
+#include "../trie.hpp"
+
+/**
+ *
+ * @brief Benchmarks do dicionário. Ficam fora do diretório do programa para
+ * não serem compilados junto com o main.cpp. Compilar, a partir deste
+ * diretório, com:
+ *   g++ -std=c++17 -O2 -pthread bench.cpp ../concurrent_trie.cpp ../trie.cpp \
+ *       ../loader.cpp ../query_io.cpp -o bench
+ *
+ * ./bench [operacoes]  (padrão 2^18 por medição)
+ *   Vazão de leitura da ConcurrentTrie em várias proporções de
+ *   leitura/escrita, comparada com a Trie protegida por um shared_mutex.
+ *
+ * ./bench consultas arquivo.dic [consultas]  (padrão 10^6)
+ *   Consultas por segundo pela entrada e saída padrão, como o programa as
+ *   responde (InputReader, OutputBuffer e uma descida por palavra) e como
+ *   eram respondidas antes (std::cin, três descidas e std::endl por linha).
+ *
+*/
+namespace {
+
+    /// Palavras aleatórias: a primeira metade é inserida antes da medição e
+    /// a segunda é inserida pelas escritas durante a medição
+    const std::size_t WORDS = 400000;
+
+    std::vector<std::string> random_words(std::size_t count) {
+        std::mt19937 random(42);
+        std::vector<std::string> words(count);
+
+        for (std::string& word : words) {
+            word.resize(3 + random() % 10);
+            for (char& c : word)
+                c = static_cast<char>('a' + random() % 26);
+        }
+
+        return words;
+    }
+
+    /**
+    * @brief Trie comum com uma trava de leitura e escrita, a alternativa
+    * sem a ConcurrentTrie
+    */
+    struct LockedTrie {
+        trie::Trie trie;
+        mutable std::shared_mutex lock;
+    };
+
+    void insert(LockedTrie& locked, const std::string& key, std::size_t position) {
+        std::unique_lock<std::shared_mutex> guard(locked.lock);
+        trie::insert(locked.trie, key, position, key.size());
+    }
+
+    int read(const LockedTrie& locked, const std::string& key) {
+        std::shared_lock<std::shared_mutex> guard(locked.lock);
+        trie::TrieView view(locked.trie);
+        return trie::contains(view, key) + trie::prefix_count(view, key.substr(0, 2));
+    }
+
+    void insert(trie::ConcurrentTrie& concurrent, const std::string& key, std::size_t position) {
+        trie::insert(concurrent, key, position, key.size());
+    }
+
+    int read(const trie::ConcurrentTrie& concurrent, const std::string& key) {
+        return trie::contains(concurrent, key)
+             + trie::prefix_count(concurrent, std::string_view(key).substr(0, 2));
+    }
+
+    /**
+    * @brief Divide "operations" entre "threads" threads; de cada 100
+    * operações, "writes" são inserções e as demais são consultas
+    * (contains e prefix_count). Retorna milhões de consultas por segundo
+    */
+    template<typename Trie>
+    double measure(const std::vector<std::string>& words, unsigned threads,
+                   unsigned writes, std::size_t operations) {
+        Trie trie;
+        const std::size_t loaded = words.size() / 2;
+        for (std::size_t i = 0; i < loaded; i++)
+            insert(trie, words[i], i);
+
+        std::vector<std::size_t> reads(threads, 0);
+        std::vector<long long> checksums(threads, 0);
+        std::vector<std::thread> pool;
+        auto start = std::chrono::steady_clock::now();
+
+        for (unsigned t = 0; t < threads; t++) {
+            pool.emplace_back([&, t]() {
+                std::minstd_rand random(t + 1);
+                std::size_t next_write = loaded + t;
+
+                for (std::size_t i = 0; i < operations / threads; i++) {
+                    if (random() % 100 < writes) {
+                        insert(trie, words[next_write], next_write);
+                        next_write += threads;
+                        if (next_write >= words.size())
+                            next_write = loaded + t;
+                    } else {
+                        checksums[t] += read(trie, words[random() % loaded]);
+                        reads[t]++;
+                    }
+                }
+            });
+        }
+
+        for (std::thread& thread : pool)
+            thread.join();
+
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        std::size_t total = 0;
+        for (unsigned t = 0; t < threads; t++) {
+            total += reads[t];
+            // toda palavra consultada já estava na trie
+            if (checksums[t] < static_cast<long long>(reads[t]))
+                std::printf("erro: palavra não encontrada\n");
+        }
+
+        return total / elapsed.count() / 1e6;
+    }
+
+    /**
+    * @brief Laço de consultas anterior à entrada e saída em blocos, mantido
+    * aqui só para comparação
+    */
+    std::size_t answer_queries_iostream(const trie::TrieView& view) {
+        std::size_t queries = 0;
+        std::string word;
+
+        while (std::cin >> word && word != "0") {
+            int count = trie::prefix_count(view, word);
+
+            if (count > 0) {
+                std::cout << word << " is prefix of " << count << " words" << std::endl;
+            } else {
+                std::cout << word << " is not prefix" << std::endl;
+            }
+
+            if (trie::contains(view, word)) {
+                const trie::TrieNode* node = trie::get(view, word);
+
+                std::cout << word << " is at (" << node->position << "," << node->length << ")" << std::endl;
+            }
+
+            queries++;
+        }
+
+        return queries;
+    }
+
+    /**
+    * @brief Grava em um arquivo temporário "count" consultas terminadas por
+    * "0": palavras do dicionário, prefixos delas e palavras aleatórias.
+    * Retorna o nome do arquivo, ou "" se não for possível criá-lo
+    */
+    std::string write_queries(const std::string& dictionary_name, std::size_t count) {
+        trie::MappedFile dictionary(dictionary_name, trie::ACCESS_SEQUENTIAL);
+        std::vector<std::string_view> words;
+        trie::for_each_entry(dictionary.contents(), [&words](const trie::Entry& entry) {
+            words.push_back(entry.key);
+        });
+
+        char name[] = "/tmp/consultas.XXXXXX";
+        int descriptor = ::mkstemp(name);
+        if (descriptor < 0 || words.empty())
+            return std::string();
+        ::close(descriptor);
+
+        std::mt19937 random(7);
+        std::ofstream file(name);
+        for (std::size_t i = 0; i < count; i++) {
+            std::string_view word = words[random() % words.size()];
+
+            switch (random() % 3) {
+                case 0:
+                    file << word;
+                    break;
+                case 1:
+                    file << word.substr(0, 1 + random() % word.size());
+                    break;
+                default:
+                    for (std::size_t c = 0; c < word.size(); c++)
+                        file << static_cast<char>('a' + random() % 26);
+            }
+
+            file << ' ';
+        }
+        file << "0\n";
+
+        return name;
+    }
+
+    /**
+    * @brief Roda "answer" com a entrada padrão lida de "queries_name" e a
+    * saída padrão descartada, três vezes, e retorna a maior vazão em
+    * consultas por segundo
+    */
+    template<typename Answer>
+    double queries_per_second(const std::string& queries_name, Answer answer) {
+        int saved_output = ::dup(STDOUT_FILENO);
+        int null_output = ::open("/dev/null", O_WRONLY);
+        ::dup2(null_output, STDOUT_FILENO);
+        ::close(null_output);
+
+        double best = 0;
+        for (int run = 0; run < 3; run++) {
+            int input = ::open(queries_name.c_str(), O_RDONLY);
+            ::dup2(input, STDIN_FILENO);
+            ::close(input);
+            std::clearerr(stdin);
+            std::cin.clear();
+
+            auto start = std::chrono::steady_clock::now();
+            std::size_t queries = answer();
+            std::cout.flush();
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+            best = std::max(best, queries / elapsed.count());
+        }
+
+        ::dup2(saved_output, STDOUT_FILENO);
+        ::close(saved_output);
+
+        return best;
+    }
+
+    /**
+    * @brief Compara a vazão das consultas antes e depois da entrada e saída
+    * em blocos, com o dicionário "dictionary_name" carregado na memória
+    */
+    int bench_queries(const std::string& dictionary_name, std::size_t count) {
+        trie::Trie dictionary;
+        std::string queries_name = write_queries(dictionary_name, count);
+
+        if (queries_name.empty() || !trie::load(dictionary, dictionary_name)) {
+            std::printf("erro: não foi possível ler %s\n", dictionary_name.c_str());
+            return -1;
+        }
+
+        const trie::TrieView view(dictionary);
+
+        double before = queries_per_second(queries_name, [&view]() {
+            return answer_queries_iostream(view);
+        });
+        double after = queries_per_second(queries_name, [&view]() {
+            trie::InputReader input;
+            trie::OutputBuffer output;
+            return trie::answer_queries(view, input, output);
+        });
+
+        std::remove(queries_name.c_str());
+
+        std::printf("consultas por segundo (milhões), %zu consultas\n", count);
+        std::printf("%12s %12s\n", "iostream", "em blocos");
+        std::printf("%12.2f %12.2f\n", before / 1e6, after / 1e6);
+        return 0;
+    }
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc > 2 && std::string(argv[1]) == "consultas") {
+        return bench_queries(argv[2], argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 1000000);
+    }
+
+    std::size_t operations = argc > 1 ? std::strtoull(argv[1], nullptr, 10)
+                                      : std::size_t{1} << 18;
+    std::vector<std::string> words = random_words(WORDS);
+
+    std::printf("consultas por segundo (milhões)\n");
+    std::printf("%8s %8s %12s %12s\n", "leitura", "threads", "shared_mutex", "concorrente");
+
+    for (unsigned writes : {0u, 1u, 10u, 50u}) {
+        for (unsigned threads : {1u, 2u, 4u, 8u}) {
+            std::printf("%7u%% %8u %12.2f %12.2f\n", 100 - writes, threads,
+                        measure<LockedTrie>(words, threads, writes, operations),
+                        measure<trie::ConcurrentTrie>(words, threads, writes, operations));
+        }
+    }
+
+    std::printf("\nnúcleos disponíveis: %u\n", std::thread::hardware_concurrency());
+    return 0;
+}
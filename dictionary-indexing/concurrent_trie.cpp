@@ -0,0 +1,200 @@
+#include <cstring>
+#include <new>
+
+#include "concurrent_trie.hpp"
+
+namespace trie {
+
+    /**
+    * Aloca uma lista de filhos com espaço para "count" filhos
+    */
+    static ConcurrentChildren* make_children(std::uint32_t count) {
+        void* memory = ::operator new(sizeof(ConcurrentChildren)
+                                      + count * (sizeof(ConcurrentNode*) + 1));
+        return new (memory) ConcurrentChildren{count};
+    }
+
+    static void free_children(const ConcurrentChildren* children) {
+        ::operator delete(const_cast<ConcurrentChildren*>(children));
+    }
+
+    /**
+    * Posição do byte "key" na lista de filhos, ou "count" se não estiver lá.
+    * As chaves são distintas, então memchr (que compara vários bytes por
+    * vez) encontra a única ocorrência
+    */
+    static std::uint32_t find_key(const ConcurrentChildren* children, unsigned char key) {
+        const void* found = std::memchr(children->keys(), key, children->count);
+
+        if (found == nullptr)
+            return children->count;
+
+        return static_cast<std::uint32_t>(static_cast<const unsigned char*>(found) - children->keys());
+    }
+
+    /**
+    * Retorna o filho de "node" pelo byte "c", ou nullptr. Não usa travas:
+    * a lista de filhos lida com acquire nunca muda depois de publicada
+    */
+    static const ConcurrentNode* child(const ConcurrentNode* node, char c) {
+        const ConcurrentChildren* children = node->children.load(std::memory_order_acquire);
+
+        if (children == nullptr)
+            return nullptr;
+
+        std::uint32_t position = find_key(children, static_cast<unsigned char>(c));
+        return position < children->count ? children->nodes()[position] : nullptr;
+    }
+
+    /**
+    * Retorna o nó ao final do percurso de "key", ou nullptr
+    */
+    static const ConcurrentNode* find_node(const ConcurrentTrie& trie, std::string_view key) {
+        const ConcurrentNode* crawlerNode = &trie.root;
+
+        for (std::size_t i = 0; i < key.length() && crawlerNode != nullptr; i++)
+            crawlerNode = child(crawlerNode, key[i]);
+
+        return crawlerNode;
+    }
+
+    /**
+    * Retorna o filho de "node" pelo byte "c", criando-o caso não exista.
+    * Só é chamada com a trava de escrita: o novo nó é inicializado antes de
+    * a nova lista de filhos ser publicada com release
+    */
+    static ConcurrentNode* add_child(ConcurrentTrie& trie, ConcurrentNode* node, char c) {
+        const ConcurrentNode* existing = child(node, c);
+        if (existing != nullptr)
+            return const_cast<ConcurrentNode*>(existing);
+
+        unsigned char key = static_cast<unsigned char>(c);
+        const ConcurrentChildren* old = node->children.load(std::memory_order_relaxed);
+        std::uint32_t count = old ? old->count : 0;
+
+        std::uint32_t position = 0;
+        while (position < count && old->keys()[position] < key)
+            position++;
+
+        ConcurrentNode* newChild = new ConcurrentNode;
+        ConcurrentChildren* children = make_children(count + 1);
+
+        for (std::uint32_t i = 0, j = 0; i <= count; i++) {
+            if (i == position) {
+                children->nodes()[i] = newChild;
+                children->keys()[i] = key;
+            } else {
+                children->nodes()[i] = old->nodes()[j];
+                children->keys()[i] = old->keys()[j];
+                j++;
+            }
+        }
+
+        node->children.store(children, std::memory_order_release);
+
+        // leitores podem ainda estar percorrendo a lista antiga
+        if (old != nullptr)
+            trie.retired_children.push_back(old);
+
+        return newChild;
+    }
+
+    /**
+    * Libera um nó, seus descendentes e sua Location atual
+    */
+    static void free_node(ConcurrentNode* node, bool owned) {
+        const ConcurrentChildren* children = node->children.load(std::memory_order_relaxed);
+
+        if (children != nullptr) {
+            for (std::uint32_t i = 0; i < children->count; i++)
+                free_node(children->nodes()[i], true);
+            free_children(children);
+        }
+
+        delete node->location.load(std::memory_order_relaxed);
+
+        if (owned)
+            delete node;
+    }
+
+    ConcurrentTrie::ConcurrentTrie() {}
+
+    ConcurrentTrie::~ConcurrentTrie() {
+        reclaim(*this);
+        free_node(&root, false);
+    }
+
+    /**
+    * Insere uma chave na trie, com posição e comprimento. Os contadores de
+    * palavras são incrementados antes de a Location ser publicada
+    */
+    void insert(ConcurrentTrie& trie, std::string_view key, std::size_t position, std::size_t length) {
+        std::lock_guard<std::mutex> lock(trie.writer);
+
+        const ConcurrentNode* found = find_node(trie, key);
+        ConcurrentNode* crawlerNode = const_cast<ConcurrentNode*>(found);
+
+        if (found == nullptr || found->location.load(std::memory_order_relaxed) == nullptr) {
+            crawlerNode = &trie.root;
+            crawlerNode->words.fetch_add(1, std::memory_order_relaxed);
+
+            for (std::size_t i = 0; i < key.length(); i++) {
+                crawlerNode = add_child(trie, crawlerNode, key[i]);
+                crawlerNode->words.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        const Location* location = new Location{position, static_cast<std::uint32_t>(length)};
+        const Location* old = crawlerNode->location.exchange(location, std::memory_order_acq_rel);
+
+        if (old != nullptr)
+            trie.retired_locations.push_back(old);
+    }
+
+    /**
+    * Verifica se uma dada chave está representada na Trie
+    */
+    bool contains(const ConcurrentTrie& trie, std::string_view key) {
+        return get(trie, key) != nullptr;
+    }
+
+    /**
+    * Conta a quantidade de palavras para qual a string "key" é prefixo
+    */
+    int prefix_count(const ConcurrentTrie& trie, std::string_view key) {
+        const ConcurrentNode* node = find_node(trie, key);
+
+        if (node == nullptr)
+            return 0;
+
+        return static_cast<int>(node->words.load(std::memory_order_relaxed));
+    }
+
+    /**
+    * Retorna a posição e o comprimento da palavra "key", ou nullptr
+    */
+    const Location* get(const ConcurrentTrie& trie, std::string_view key) {
+        const ConcurrentNode* node = find_node(trie, key);
+
+        if (node == nullptr)
+            return nullptr;
+
+        return node->location.load(std::memory_order_acquire);
+    }
+
+    /**
+    * Libera as versões substituídas, que nenhum leitor pode mais alcançar
+    */
+    void reclaim(ConcurrentTrie& trie) {
+        std::lock_guard<std::mutex> lock(trie.writer);
+
+        for (const ConcurrentChildren* children : trie.retired_children)
+            free_children(children);
+        for (const Location* location : trie.retired_locations)
+            delete location;
+
+        trie.retired_children.clear();
+        trie.retired_locations.clear();
+    }
+
+}  // namespace trie
@@ -0,0 +1,198 @@
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include "index.hpp"
+
+namespace trie {
+
+    static const char INDEX_MAGIC[8] = "TRIEIDX";
+
+    /**
+    * Preenche o tamanho e a data de modificação de um arquivo. Retorna false
+    * se o arquivo não existir.
+    */
+    static bool source_stat(const std::string& source_name, IndexHeader& header) {
+        struct stat status;
+
+        if (::stat(source_name.c_str(), &status) != 0)
+            return false;
+
+        header.source_size = static_cast<std::uint64_t>(status.st_size);
+        header.source_mtime_sec = static_cast<std::int64_t>(status.st_mtim.tv_sec);
+        header.source_mtime_nsec = static_cast<std::int64_t>(status.st_mtim.tv_nsec);
+        return true;
+    }
+
+    /**
+    * Checksum FNV-1a aplicado a palavras de 8 bytes (e byte a byte no final)
+    */
+    static std::uint64_t checksum(const char* data, std::size_t size, std::uint64_t hash) {
+        const std::uint64_t prime = 1099511628211ull;
+        std::size_t i = 0;
+
+        for (; i + 8 <= size; i += 8) {
+            std::uint64_t word;
+            std::memcpy(&word, data + i, 8);
+            hash = (hash ^ word) * prime;
+        }
+
+        for (; i < size; i++)
+            hash = (hash ^ static_cast<unsigned char>(data[i])) * prime;
+
+        return hash;
+    }
+
+    /**
+    * Checksum dos nós seguidos dos filhos
+    */
+    static std::uint64_t checksum(const TrieView& trie) {
+        std::uint64_t hash = 14695981039346656037ull;
+
+        hash = checksum(reinterpret_cast<const char*>(trie.nodes),
+                        trie.node_count * sizeof(TrieNode), hash);
+        hash = checksum(reinterpret_cast<const char*>(trie.children),
+                        trie.children_count * sizeof(std::uint32_t), hash);
+
+        return hash;
+    }
+
+    /**
+    * Confere se o arquivo "file_name" tem o checksum gravado no cabeçalho.
+    * O arquivo é lido do início ao fim uma única vez
+    */
+    static bool verify_checksum(const std::string& file_name) {
+        MappedFile file(file_name, ACCESS_SEQUENTIAL);
+        std::string_view contents = file.contents();
+
+        if (contents.size() < sizeof(IndexHeader))
+            return false;
+
+        IndexHeader header;
+        std::memcpy(&header, contents.data(), sizeof(header));
+
+        const char* nodes = contents.data() + sizeof(IndexHeader);
+        std::size_t nodes_size = header.node_count * sizeof(TrieNode);
+        std::size_t children_size = header.children_count * sizeof(std::uint32_t);
+
+        if (contents.size() != sizeof(IndexHeader) + nodes_size + children_size)
+            return false;
+
+        // mesma ordem de checksum(const TrieView&): nós e depois filhos
+        std::uint64_t hash = checksum(nodes, nodes_size, 14695981039346656037ull);
+        hash = checksum(nodes + nodes_size, children_size, hash);
+
+        return hash == header.checksum;
+    }
+
+    /**
+    * Grava a trie em um arquivo temporário de nome único, confere o que foi
+    * gravado pelo checksum e só então o renomeia para "index_name". Assim um
+    * índice incompleto nunca é lido, e processos que reconstroem o mesmo
+    * índice ao mesmo tempo não escrevem no mesmo arquivo temporário
+    */
+    bool write_index(const TrieView& trie, const std::string& index_name,
+                     const std::string& source_name) {
+        IndexHeader header;
+        std::memset(&header, 0, sizeof(header));
+
+        if (!source_stat(source_name, header))
+            return false;
+
+        std::memcpy(header.magic, INDEX_MAGIC, sizeof(header.magic));
+        header.version = INDEX_VERSION;
+        header.node_size = sizeof(TrieNode);
+        header.node_count = trie.node_count;
+        header.children_count = trie.children_count;
+        header.checksum = checksum(trie);
+
+        std::string temporary_name = index_name + ".XXXXXX";
+        int descriptor = ::mkstemp(&temporary_name[0]);
+
+        if (descriptor < 0)
+            return false;
+
+        // mkstemp cria o arquivo só com permissão para o dono
+        ::fchmod(descriptor, 0644);
+        ::close(descriptor);
+
+        std::ofstream file(temporary_name, std::ios::binary | std::ios::trunc);
+
+        if (!file.is_open()) {
+            std::remove(temporary_name.c_str());
+            return false;
+        }
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(trie.nodes),
+                   trie.node_count * sizeof(TrieNode));
+        file.write(reinterpret_cast<const char*>(trie.children),
+                   trie.children_count * sizeof(std::uint32_t));
+        file.close();
+
+        if (!file || !verify_checksum(temporary_name)
+            || std::rename(temporary_name.c_str(), index_name.c_str()) != 0) {
+            std::remove(temporary_name.c_str());
+            return false;
+        }
+
+        return true;
+    }
+
+    /**
+    * Mapeia o índice e confere cabeçalho, tamanho e origem. O checksum já foi
+    * conferido na gravação: percorrer o índice inteiro aqui atrasaria a
+    * primeira consulta, que deve ser imediata
+    */
+    MappedIndex::MappedIndex(const std::string& index_name, const std::string& source_name):
+        // as consultas acessam os nós do índice fora de ordem
+        file_{index_name, ACCESS_RANDOM},
+        header_{nullptr}
+    {
+        std::string_view contents = file_.contents();
+
+        if (contents.size() < sizeof(IndexHeader))
+            return;
+
+        const IndexHeader* header = reinterpret_cast<const IndexHeader*>(contents.data());
+
+        if (std::memcmp(header->magic, INDEX_MAGIC, sizeof(header->magic)) != 0
+            || header->version != INDEX_VERSION
+            || header->node_size != sizeof(TrieNode)
+            || header->node_count == 0)
+            return;
+
+        std::uint64_t expected_size = sizeof(IndexHeader)
+                                    + header->node_count * sizeof(TrieNode)
+                                    + header->children_count * sizeof(std::uint32_t);
+        if (contents.size() != expected_size)
+            return;
+
+        // o índice só vale para o dicionário exatamente como ele estava
+        IndexHeader source;
+        if (!source_stat(source_name, source)
+            || source.source_size != header->source_size
+            || source.source_mtime_sec != header->source_mtime_sec
+            || source.source_mtime_nsec != header->source_mtime_nsec)
+            return;
+
+        header_ = header;
+    }
+
+    bool MappedIndex::is_valid() const {
+        return header_ != nullptr;
+    }
+
+    TrieView MappedIndex::view() const {
+        const char* base = reinterpret_cast<const char*>(header_);
+        const TrieNode* nodes = reinterpret_cast<const TrieNode*>(base + sizeof(IndexHeader));
+        const std::uint32_t* children = reinterpret_cast<const std::uint32_t*>(
+            base + sizeof(IndexHeader) + header_->node_count * sizeof(TrieNode));
+
+        return TrieView(nodes, header_->node_count, children, header_->children_count);
+    }
+
+}  // namespace trie
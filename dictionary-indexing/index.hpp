@@ -0,0 +1,76 @@
+#ifndef TRIE_INDEX_HPP
+#define TRIE_INDEX_HPP
+
+#include <cstdint>
+#include <string>
+
+#include "loader.hpp"
+#include "trie.hpp"
+
+/**
+ * 
+ * @brief Índice da trie em disco. O arquivo é uma cópia direta dos vetores
+ * de nós e de filhos, que só usam índices relativos, e pode ser mapeado e
+ * consultado sem nenhuma desserialização.
+ * 
+*/
+namespace trie {
+
+    /**
+     * @brief Versão do formato. Deve mudar junto com o layout de TrieNode
+    */
+    const std::uint32_t INDEX_VERSION = 3;
+
+    /**
+     * @brief Cabeçalho do índice, seguido pelos nós e depois pelos filhos.
+     * Guarda o tamanho e a data de modificação do .dic de origem, para que
+     * um índice desatualizado seja detectado, e um checksum do conteúdo,
+     * conferido logo depois da gravação.
+    */
+    struct IndexHeader {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t node_size;
+        std::uint64_t source_size;
+        std::int64_t source_mtime_sec;
+        std::int64_t source_mtime_nsec;
+        std::uint64_t node_count;
+        std::uint64_t children_count;
+        std::uint64_t checksum;
+    };
+
+    /**
+    * @brief Grava a trie no arquivo "index_name", associada ao dicionário
+    * "source_name". Retorna false se não for possível gravar.
+    */
+    bool write_index(const TrieView& trie, const std::string& index_name,
+                     const std::string& source_name);
+
+    /**
+     * @brief Índice mapeado do disco, somente leitura. Só é válido se o
+     * arquivo existir, tiver o formato e o tamanho corretos e corresponder à
+     * versão atual do dicionário "source_name". O checksum é conferido por
+     * write_index(), antes de o índice ser publicado.
+    */
+    class MappedIndex {
+     public:
+        MappedIndex(const std::string& index_name, const std::string& source_name);
+
+        /**
+        * @brief Indica se o índice pode ser usado
+        */
+        bool is_valid() const;
+
+        /**
+        * @brief Trie mapeada, válida enquanto o MappedIndex existir
+        */
+        TrieView view() const;
+
+     private:
+        MappedFile file_;
+        const IndexHeader* header_;
+    };
+
+}  // namespace trie
+
+#endif
@@ -0,0 +1,153 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <exception>
+#include <thread>
+
+#include "loader.hpp"
+
+namespace trie {
+
+    /**
+    * Abre e mapeia o arquivo inteiro. Arquivos vazios não são mapeados,
+    * mas são considerados abertos.
+    */
+    MappedFile::MappedFile(const std::string& file_name, Access access):
+        data_{nullptr},
+        size_{0},
+        open_{false}
+    {
+        int descriptor = ::open(file_name.c_str(), O_RDONLY);
+        if (descriptor < 0)
+            return;
+
+        struct stat status;
+        if (::fstat(descriptor, &status) == 0) {
+            size_ = static_cast<std::size_t>(status.st_size);
+
+            if (size_ == 0) {
+                open_ = true;
+            } else {
+                void* address = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, descriptor, 0);
+
+                if (address != MAP_FAILED) {
+                    ::madvise(address, size_,
+                              access == ACCESS_SEQUENTIAL ? MADV_SEQUENTIAL : MADV_RANDOM);
+                    data_ = static_cast<const char*>(address);
+                    open_ = true;
+                }
+            }
+        }
+
+        ::close(descriptor);
+    }
+
+    MappedFile::~MappedFile() {
+        if (data_ != nullptr)
+            ::munmap(const_cast<char*>(data_), size_);
+    }
+
+    bool MappedFile::is_open() const {
+        return open_;
+    }
+
+    std::string_view MappedFile::contents() const {
+        return std::string_view(data_, data_ ? size_ : 0);
+    }
+
+    /**
+    * Insere na trie as entradas usando várias threads, uma trie por thread
+    */
+    void build_parallel(Trie& trie, const std::vector<Entry>& entries, unsigned threads) {
+        // quantidade de entradas por primeira letra; a chave vazia fica na
+        // própria raiz e é inserida diretamente
+        std::size_t letterCount[256] = {};
+        for (const Entry& entry : entries) {
+            if (entry.key.empty())
+                insert(trie, entry.key, entry.position, entry.length);
+            else
+                letterCount[static_cast<unsigned char>(entry.key[0])]++;
+        }
+
+        // distribui as letras, da mais frequente para a menos, para a thread
+        // com menos entradas até o momento
+        std::vector<unsigned> letters;
+        for (unsigned letter = 0; letter < 256; letter++)
+            if (letterCount[letter] > 0)
+                letters.push_back(letter);
+
+        std::sort(letters.begin(), letters.end(), [&letterCount](unsigned a, unsigned b) {
+            return letterCount[a] > letterCount[b];
+        });
+
+        threads = std::max(1u, std::min<unsigned>(threads, letters.size()));
+
+        unsigned owner[256];
+        std::vector<std::size_t> load(threads, 0);
+        for (unsigned letter : letters) {
+            unsigned lightest = std::min_element(load.begin(), load.end()) - load.begin();
+            owner[letter] = lightest;
+            load[lightest] += letterCount[letter];
+        }
+
+        std::vector<Trie> subtries(threads);
+        std::vector<std::exception_ptr> errors(threads);
+        std::vector<std::thread> workers;
+
+        for (unsigned worker = 0; worker < threads; worker++) {
+            workers.emplace_back([&, worker]() {
+                try {
+                    for (const Entry& entry : entries) {
+                        if (!entry.key.empty()
+                            && owner[static_cast<unsigned char>(entry.key[0])] == worker)
+                            insert(subtries[worker], entry.key, entry.position, entry.length);
+                    }
+                } catch (...) {
+                    errors[worker] = std::current_exception();
+                }
+            });
+        }
+
+        for (std::thread& thread : workers)
+            thread.join();
+
+        for (const std::exception_ptr& error : errors)
+            if (error)
+                std::rethrow_exception(error);
+
+        for (const Trie& subtrie : subtries)
+            attach(trie, subtrie);
+    }
+
+    /**
+    * Insere na trie todas as palavras do arquivo de dicionário
+    */
+    bool load(Trie& trie, const std::string& file_name, unsigned threads) {
+        // o dicionário é lido do início ao fim uma única vez
+        MappedFile file(file_name, ACCESS_SEQUENTIAL);
+
+        if (!file.is_open())
+            return false;
+
+        if (threads <= 1) {
+            for_each_entry(file.contents(), [&trie](const Entry& entry) {
+                insert(trie, entry.key, entry.position, entry.length);
+            });
+        } else {
+            // as chaves das entradas apontam para o arquivo mapeado, que
+            // continua aberto até o fim da construção
+            std::vector<Entry> entries;
+            for_each_entry(file.contents(), [&entries](const Entry& entry) {
+                entries.push_back(entry);
+            });
+
+            build_parallel(trie, entries, threads);
+        }
+
+        return true;
+    }
+
+}  // namespace trie
@@ -0,0 +1,122 @@
+#ifndef TRIE_LOADER_HPP
+#define TRIE_LOADER_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "trie.hpp"
+
+/**
+ * 
+ * @brief Leitura de arquivos de dicionário diretamente da memória mapeada,
+ * sem cópias das linhas ou das palavras.
+ * 
+*/
+namespace trie {
+
+    /**
+     * @brief Como o arquivo mapeado será lido, repassado ao madvise:
+     * ACCESS_SEQUENTIAL para uma leitura do início ao fim (antecipa as
+     * próximas páginas), ACCESS_RANDOM para acessos espalhados, como as
+     * consultas a um índice (não lê páginas além das acessadas).
+    */
+    enum Access {
+        ACCESS_SEQUENTIAL,
+        ACCESS_RANDOM
+    };
+
+    /**
+     * @brief Arquivo mapeado em memória, somente leitura. O mapeamento é
+     * desfeito no destrutor.
+    */
+    class MappedFile {
+     public:
+        MappedFile(const std::string& file_name, Access access);
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /**
+        * @brief Indica se o arquivo foi aberto e mapeado
+        */
+        bool is_open() const;
+
+        /**
+        * @brief Conteúdo do arquivo, válido enquanto o MappedFile existir
+        */
+        std::string_view contents() const;
+
+     private:
+        const char* data_;
+        std::size_t size_;
+        bool open_;
+    };
+
+    /**
+     * @brief Palavra de uma linha do dicionário, com a posição do início da
+     * linha (o '[') e o comprimento da linha, sem o '\n'
+    */
+    struct Entry {
+        std::string_view key;
+        std::size_t position;
+        std::size_t length;
+    };
+
+    /**
+    * @brief Chama "callback" com a Entry de cada linha de "contents", em ordem.
+    * A palavra é o trecho entre o primeiro caractere da linha e o ']'. As
+    * buscas por '\n' e ']' usam memchr, que percorre vários bytes por vez.
+    */
+    template<typename Callback>
+    void for_each_entry(std::string_view contents, Callback callback) {
+        const char* begin = contents.data();
+        const char* end = begin + contents.size();
+        const char* line = begin;
+
+        while (line < end) {
+            const char* newline = static_cast<const char*>(
+                std::memchr(line, '\n', end - line));
+            const char* line_end = newline ? newline : end;
+            std::size_t length = line_end - line;
+
+            if (length > 0) {
+                const char* bracket = static_cast<const char*>(
+                    std::memchr(line, ']', length));
+                // sem ']' (ou com ']' no lugar do '['), vai até o fim da linha
+                const char* key_end = (bracket && bracket != line) ? bracket : line_end;
+
+                callback(Entry{
+                    std::string_view(line + 1, key_end - line - 1),
+                    static_cast<std::size_t>(line - begin),
+                    length
+                });
+            }
+
+            line = line_end + 1;
+        }
+    }
+
+    /**
+    * @brief Insere na trie as entradas de "entries" usando até "threads"
+    * threads. As entradas são separadas pela primeira letra da palavra; cada
+    * thread constrói uma trie só com as letras que recebeu, na ordem original
+    * das entradas, e as tries são depois anexadas à raiz. O resultado das
+    * consultas é o mesmo da inserção sequencial, inclusive para palavras
+    * repetidas.
+    */
+    void build_parallel(Trie& trie, const std::vector<Entry>& entries, unsigned threads);
+
+    /**
+    * @brief Insere na trie todas as palavras do arquivo de dicionário
+    * "file_name", usando "threads" threads se for maior que 1. Retorna false
+    * se o arquivo não puder ser aberto.
+    */
+    bool load(Trie& trie, const std::string& file_name, unsigned threads = 1);
+
+}  // namespace trie
+
+#endif
@@ -1,58 +1,44 @@
-#include <iostream>
-#include <fstream>
-#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
 
+#include "index.hpp"
+#include "loader.hpp"
+#include "query_io.hpp"
 #include "trie.hpp"
 
 int main() {
     
-    std::ifstream file;
-    std::string file_name;
-    std::string word;
+    trie::InputReader input;
+    trie::OutputBuffer output;
+    std::string_view token;
 
-    std::cin >> file_name;
-
-    file.open(file_name);
-    
-    if (!file.is_open()) {
-        std::cout << "error\n";
+    if (!input.next(token)) {
+        output << "error\n";
         return -1;
     }
-    
-    struct trie::TrieNode *root = trie::getRoot();
 
-    std::string line;
-    size_t char_count = 0;
+    std::string file_name(token);
 
-    while (std::getline(file, line)) {
-        std::string word = line.substr(1, line.find_first_of(']') - 1);
-        trie::insert(root, word, char_count, line.length());
-        char_count += line.length() + 1;
-    }
+    // Usa o índice gravado em disco quando ele corresponde ao dicionário;
+    // do contrário constrói a trie a partir do .dic e grava um novo índice
+    std::string index_name = file_name + ".idx";
+    trie::MappedIndex index(index_name, file_name);
+    trie::Trie dictionary;
 
-    file.close();
-    
-    while(1) {
-        std::cin >> word;
-
-        if (word.compare("0") == 0) {
-            break;
+    if (!index.is_valid()) {
+        if (!trie::load(dictionary, file_name, std::thread::hardware_concurrency())) {
+            output << "error\n";
+            return -1;
         }
 
-        int count = trie::prefix_count(root, word);
-
-        if (count > 0) {
-            std::cout << word << " is prefix of " << count << " words" << std::endl;
-        } else {
-            std::cout << word << " is not prefix" << std::endl;
-        }
-
-        if (trie::contains(root, word)) {
-            trie::TrieNode* node = trie::get(root, word);
-
-            std::cout << word << " is at (" << node->position << "," << node->length << ")" << std::endl; 
-        }
+        // uma falha ao gravar o índice não impede as consultas
+        trie::write_index(dictionary, index_name, file_name);
     }
 
+    const trie::TrieView view = index.is_valid() ? index.view() : trie::TrieView(dictionary);
+    
+    trie::answer_queries(view, input, output);
+
     return 0;
-}   
\ No newline at end of file
+}
@@ -0,0 +1,82 @@
+#include <unistd.h>
+
+#include <charconv>
+
+#include "query_io.hpp"
+
+namespace trie {
+
+    /**
+    * Descarta o que já foi consumido e lê mais um bloco da entrada padrão
+    */
+    void InputReader::fill() {
+        buffer_.erase(0, position_);
+        position_ = 0;
+
+        std::size_t used = buffer_.size();
+        buffer_.resize(used + BLOCK_SIZE);
+        ssize_t count = ::read(STDIN_FILENO, &buffer_[used], BLOCK_SIZE);
+        buffer_.resize(used + (count > 0 ? count : 0));
+
+        if (count <= 0)
+            eof_ = true;
+    }
+
+    OutputBuffer& OutputBuffer::operator<<(std::uint64_t number) {
+        char digits[20];
+        auto result = std::to_chars(digits, digits + sizeof(digits), number);
+        return *this << std::string_view(digits, result.ptr - digits);
+    }
+
+    /**
+    * Grava o buffer inteiro na saída padrão
+    */
+    void OutputBuffer::flush() {
+        std::size_t written = 0;
+
+        while (written < buffer_.size()) {
+            ssize_t count = ::write(STDOUT_FILENO, buffer_.data() + written,
+                                    buffer_.size() - written);
+            if (count <= 0)
+                break;
+            written += count;
+        }
+
+        buffer_.clear();
+    }
+
+    /**
+    * Responde as consultas de tudo o que já foi lido de uma vez
+    */
+    std::size_t answer_queries(const TrieView& view, InputReader& input, OutputBuffer& output) {
+        std::size_t queries = 0;
+        std::string_view word;
+
+        while (input.next(word)) {
+            if (word == "0") {
+                break;
+            }
+
+            // uma única descida na trie responde as duas perguntas
+            const TrieNode* node = find(view, word);
+
+            if (node != nullptr && node->words > 0) {
+                output << word << " is prefix of " << node->words << " words\n";
+            } else {
+                output << word << " is not prefix\n";
+            }
+
+            if (node != nullptr && node->leaf) {
+                output << word << " is at (" << node->position << "," << node->length << ")\n";
+            }
+
+            queries++;
+
+            if (input.drained())
+                output.flush();
+        }
+
+        return queries;
+    }
+
+}  // namespace trie
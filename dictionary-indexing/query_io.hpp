@@ -0,0 +1,130 @@
+#ifndef TRIE_QUERY_IO_HPP
+#define TRIE_QUERY_IO_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "trie.hpp"
+
+/**
+ *
+ * @brief Entrada e saída das consultas do programa: leitura da entrada
+ * padrão e escrita na saída padrão em blocos, sem uma chamada por palavra.
+ *
+*/
+namespace trie {
+
+    /**
+     * @brief Lê a entrada padrão em blocos grandes e a separa em palavras.
+     * Cada bloco é consumido inteiro antes de uma nova leitura.
+    */
+    class InputReader {
+     public:
+        InputReader() {
+            buffer_.reserve(BLOCK_SIZE);
+        }
+
+        /**
+        * @brief Coloca a próxima palavra em "word". Retorna false no fim da
+        * entrada. "word" aponta para o buffer interno e vale até a próxima
+        * chamada
+        */
+        bool next(std::string_view& word) {
+            while (true) {
+                skip_spaces();
+
+                std::size_t end = position_;
+                while (end < buffer_.size() && !is_space(buffer_[end]))
+                    end++;
+
+                // a palavra só está completa se terminou antes do fim do
+                // buffer, ou se não há mais nada a ler
+                if (end < buffer_.size() || (eof_ && end > position_)) {
+                    word = std::string_view(buffer_).substr(position_, end - position_);
+                    position_ = end;
+                    return true;
+                }
+
+                if (eof_)
+                    return false;
+
+                fill();
+            }
+        }
+
+        /**
+        * @brief Indica se não há mais dados já lidos esperando processamento,
+        * ou seja, se a próxima palavra exigirá uma nova leitura
+        */
+        bool drained() {
+            skip_spaces();
+            return position_ == buffer_.size();
+        }
+
+     private:
+        static const std::size_t BLOCK_SIZE = 1 << 16;
+
+        static bool is_space(char c) {
+            return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+        }
+
+        void skip_spaces() {
+            while (position_ < buffer_.size() && is_space(buffer_[position_]))
+                position_++;
+        }
+
+        /**
+        * Descarta o que já foi consumido e lê mais um bloco
+        */
+        void fill();
+
+        std::string buffer_;
+        std::size_t position_{0};
+        bool eof_{false};
+    };
+
+    /**
+     * @brief Acumula a saída em memória e a grava na saída padrão em blocos
+     * grandes, em vez de uma escrita por linha
+    */
+    class OutputBuffer {
+     public:
+        OutputBuffer() {
+            buffer_.reserve(BLOCK_SIZE + 256);
+        }
+
+        ~OutputBuffer() {
+            flush();
+        }
+
+        OutputBuffer& operator<<(std::string_view text) {
+            buffer_.append(text);
+            if (buffer_.size() >= BLOCK_SIZE)
+                flush();
+            return *this;
+        }
+
+        OutputBuffer& operator<<(std::uint64_t number);
+
+        void flush();
+
+     private:
+        static const std::size_t BLOCK_SIZE = 1 << 16;
+
+        std::string buffer_;
+    };
+
+
+    /**
+    * @brief Responde as consultas lidas de "input" até o "0" ou o fim da
+    * entrada, gravando as respostas em "output". A saída é gravada apenas
+    * quando for preciso esperar por mais entrada. Retorna a quantidade de
+    * consultas respondidas
+    */
+    std::size_t answer_queries(const TrieView& view, InputReader& input, OutputBuffer& output);
+
+}  // namespace trie
+
+#endif
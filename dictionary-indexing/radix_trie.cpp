@@ -0,0 +1,224 @@
+#include <algorithm>
+#include <cstring>
+
+#include "loader.hpp"
+#include "radix_trie.hpp"
+#include "trie.hpp"
+
+namespace trie {
+
+    RadixTrie::RadixTrie() {
+        nodes.push_back(RadixNode{0, 0, 0, 0, NO_NODE, NO_NODE, 0, false});
+    }
+
+    /**
+    * Retorna o primeiro byte do rótulo de "node", sem sinal, para que os
+    * irmãos fiquem na mesma ordem de bytes da Trie
+    */
+    static unsigned char first_letter(const RadixTrie& trie, std::uint32_t node) {
+        return static_cast<unsigned char>(trie.labels[trie.nodes[node].label]);
+    }
+
+    /**
+    * Retorna o filho de "node" cujo rótulo começa com "c", ou NO_NODE
+    */
+    static std::uint32_t child(const RadixTrie& trie, std::uint32_t node, unsigned char c) {
+        std::uint32_t current = trie.nodes[node].first_child;
+
+        while (current != NO_NODE && first_letter(trie, current) < c)
+            current = trie.nodes[current].next_sibling;
+
+        if (current != NO_NODE && first_letter(trie, current) == c)
+            return current;
+
+        return NO_NODE;
+    }
+
+    /**
+    * Quantidade de letras iguais no começo do rótulo de "node" e de "key"
+    */
+    static std::size_t common_prefix(const RadixTrie& trie, std::uint32_t node, std::string_view key) {
+        const RadixNode& current = trie.nodes[node];
+        const char* label = trie.labels.data() + current.label;
+        std::size_t limit = std::min<std::size_t>(current.label_length, key.length());
+
+        std::size_t i = 0;
+        while (i < limit && label[i] == key[i])
+            i++;
+
+        return i;
+    }
+
+    /**
+    * Percorre "key" a partir da raiz. Retorna o nó em que o percurso termina,
+    * ou NO_NODE se ele sair da trie. "offset" recebe quantas letras do rótulo
+    * desse nó foram usadas; se for menor que o rótulo, "key" termina no meio
+    * da aresta
+    */
+    static std::uint32_t find_node(const RadixTrie& trie, std::string_view key, std::size_t& offset) {
+        std::uint32_t crawlerNode = 0;
+        offset = 0;
+
+        while (!key.empty()) {
+            crawlerNode = child(trie, crawlerNode, key[0]);
+
+            if (crawlerNode == NO_NODE)
+                return NO_NODE;
+
+            const RadixNode& current = trie.nodes[crawlerNode];
+            offset = std::min<std::size_t>(current.label_length, key.length());
+
+            if (std::memcmp(trie.labels.data() + current.label, key.data(), offset) != 0)
+                return NO_NODE;
+
+            key.remove_prefix(offset);
+        }
+
+        return crawlerNode;
+    }
+
+    /**
+    * Divide "node" depois de "split" letras do rótulo. O nó mantém seu índice
+    * e a primeira parte do rótulo; um novo nó, seu único filho, recebe o
+    * restante do rótulo, os filhos e os dados da palavra
+    */
+    static void split_node(RadixTrie& trie, std::uint32_t node, std::size_t split) {
+        RadixNode lower = trie.nodes[node];
+        lower.label += static_cast<std::uint32_t>(split);
+        lower.label_length -= static_cast<std::uint32_t>(split);
+        lower.next_sibling = NO_NODE;
+        trie.nodes.push_back(lower);
+
+        RadixNode& upper = trie.nodes[node];
+        upper.label_length = static_cast<std::uint32_t>(split);
+        upper.first_child = static_cast<std::uint32_t>(trie.nodes.size() - 1);
+        upper.leaf = false;
+        upper.position = 0;
+        upper.length = 0;
+    }
+
+    /**
+    * Cria um nó com rótulo "label" e o liga como filho de "node", mantendo
+    * a ordem alfabética dos irmãos
+    */
+    static std::uint32_t add_child(RadixTrie& trie, std::uint32_t node, std::string_view label) {
+        std::uint32_t newChild = static_cast<std::uint32_t>(trie.nodes.size());
+        std::uint32_t offset = static_cast<std::uint32_t>(trie.labels.size());
+
+        trie.labels.append(label.data(), label.size());
+        trie.nodes.push_back(RadixNode{0, 0, offset, static_cast<std::uint32_t>(label.size()),
+                                       NO_NODE, NO_NODE, 0, false});
+
+        std::uint32_t* link = &trie.nodes[node].first_child;
+        while (*link != NO_NODE && first_letter(trie, *link) < static_cast<unsigned char>(label[0]))
+            link = &trie.nodes[*link].next_sibling;
+
+        trie.nodes[newChild].next_sibling = *link;
+        *link = newChild;
+
+        return newChild;
+    }
+
+    /**
+    * Insere uma chave na raiz da trie, com posição e comprimento
+    */
+    void insert(RadixTrie& trie, std::string_view key, std::size_t position, std::size_t length) {
+        std::size_t offset;
+        std::uint32_t found = find_node(trie, key, offset);
+        bool known = (found != NO_NODE || key.empty())
+                     && offset == trie.nodes[found].label_length
+                     && trie.nodes[found].leaf;
+
+        std::uint32_t crawlerNode = 0;
+        if (!known)
+            trie.nodes[crawlerNode].words++;
+
+        // Palavra nova: cada nó do percurso conta mais uma palavra. Um nó
+        // cujo rótulo não é prefixo do restante da chave é dividido antes
+        while (!key.empty()) {
+            std::uint32_t next = child(trie, crawlerNode, key[0]);
+
+            if (next == NO_NODE) {
+                crawlerNode = add_child(trie, crawlerNode, key);
+                key = std::string_view();
+            } else {
+                std::size_t matched = common_prefix(trie, next, key);
+
+                if (matched < trie.nodes[next].label_length)
+                    split_node(trie, next, matched);
+
+                crawlerNode = next;
+                key.remove_prefix(matched);
+            }
+
+            if (!known)
+                trie.nodes[crawlerNode].words++;
+        }
+
+        RadixNode& node = trie.nodes[crawlerNode];
+        node.leaf = true;
+        node.position = position;
+        node.length = static_cast<std::uint32_t>(length);
+    }
+
+    /**
+    * Retorna o nó da palavra "key", ou NO_NODE se ela não estiver na trie.
+    * Como a raiz nunca é filha, a chave vazia é a única que pode terminar nela
+    */
+    static std::uint32_t find_word(const RadixTrie& trie, std::string_view key) {
+        std::size_t offset;
+        std::uint32_t node = find_node(trie, key, offset);
+
+        if ((node == NO_NODE && !key.empty())
+            || offset != trie.nodes[node].label_length
+            || !trie.nodes[node].leaf)
+            return NO_NODE;
+
+        return node;
+    }
+
+    /**
+    * Verifica se uma dada chave está representada na Trie
+    */
+    bool contains(const RadixTrie& trie, std::string_view key) {
+        return find_word(trie, key) != NO_NODE || (key.empty() && trie.nodes[0].leaf);
+    }
+
+    /**
+    * Conta a quantidade de palavras para qual a string "key" é prefixo. Se
+    * "key" termina no meio de um rótulo, são as palavras do nó do rótulo
+    */
+    int prefix_count(const RadixTrie& trie, std::string_view key) {
+        std::size_t offset;
+        std::uint32_t node = find_node(trie, key, offset);
+
+        if (node == NO_NODE && !key.empty())
+            return 0;
+
+        return static_cast<int>(trie.nodes[node].words);
+    }
+
+    /**
+    * Retorna o nó da palavra "key", ou a raiz
+    */
+    const RadixNode* get(const RadixTrie& trie, std::string_view key) {
+        return &trie.nodes[find_word(trie, key)];
+    }
+
+    /**
+    * Insere na RadixTrie todas as palavras do arquivo de dicionário
+    */
+    bool load(RadixTrie& trie, const std::string& file_name) {
+        MappedFile file(file_name, ACCESS_SEQUENTIAL);
+
+        if (!file.is_open())
+            return false;
+
+        for_each_entry(file.contents(), [&trie](const Entry& entry) {
+            insert(trie, entry.key, entry.position, entry.length);
+        });
+
+        return true;
+    }
+
+}  // namespace trie
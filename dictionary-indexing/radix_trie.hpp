@@ -0,0 +1,78 @@
+#ifndef TRIE_RADIX_TRIE_HPP
+#define TRIE_RADIX_TRIE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * 
+ * @brief Variante compactada (Radix/Patricia) da Trie: cadeias de nós com um
+ * único filho viram um só nó, cujo rótulo tem várias letras.
+ * 
+*/
+namespace trie {
+
+    /**
+     * @brief Nó da RadixTrie. O rótulo do nó é o trecho de RadixTrie::labels
+     * que começa em "label" e tem "label_length" letras. Os filhos formam uma
+     * lista encadeada por "next_sibling", a partir de "first_child", em ordem
+     * crescente do primeiro byte do rótulo; irmãos nunca começam pelo mesmo
+     * byte. "words" é a quantidade de palavras que passam pelo nó.
+    */
+    struct RadixNode {
+        std::uint64_t position;
+        std::uint32_t length;
+        std::uint32_t label;
+        std::uint32_t label_length;
+        std::uint32_t first_child;
+        std::uint32_t next_sibling;
+        std::uint32_t words;
+        bool leaf;
+    };
+
+    /**
+     * @brief RadixTrie dona de todos os seus nós e rótulos. A raiz é sempre o
+     * nó 0 e tem rótulo vazio. Dividir um nó não copia letras: os dois nós
+     * passam a apontar para partes do mesmo rótulo.
+    */
+    struct RadixTrie {
+        RadixTrie();
+
+        std::vector<RadixNode> nodes;
+        std::string labels;
+    };
+
+    /**
+    * @brief Insere uma chave na raiz da trie, com posição e comprimento.
+    */
+    void insert(RadixTrie& trie, std::string_view key, size_t position, size_t length);
+
+    /**
+    * @brief Verifica se uma dada chave está representada na Trie
+    */
+    bool contains(const RadixTrie& trie, std::string_view key);
+
+    /**
+    * @brief Conta a quantidade de palavras para qual a string "key" é prefixo
+    */
+    int prefix_count(const RadixTrie& trie, std::string_view key);
+
+    /**
+    * @brief Retorna o nó da palavra "key". Caso a chave não esteja na Trie,
+    * retorna a raiz
+    */
+    const RadixNode* get(const RadixTrie& trie, std::string_view key);
+
+    /**
+    * @brief Insere na RadixTrie todas as palavras do arquivo de dicionário
+    * "file_name", lido pelo loader.hpp. Retorna false se o arquivo não puder
+    * ser aberto.
+    */
+    bool load(RadixTrie& trie, const std::string& file_name);
+
+}  // namespace trie
+
+#endif
@@ -1,149 +1,598 @@
-#ifndef STRUCTURES_BINARY_TREE_H
-#define STRUCTURES_BINARY_TREE_H
-#define ALPHABET_SIZE 26
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
-#include <iostream>
 #include "trie.hpp"
 
 namespace trie {
+    /// Quantidade máxima de filhos de cada tipo de nó
+    static const unsigned CAPACITY[NODE_TYPES] = {0, 4, 16, 48, 256};
+
+    /// Palavras de 32 bits ocupadas pelas chaves, antes dos índices dos filhos
+    static const unsigned KEY_WORDS[NODE_TYPES] = {0, 1, 4, 64, 0};
+
     /**
-    * Retorna um nodo com filhos nulos e o dado recebido
+    * Bytes das chaves do espaço que começa em "span"
     */
-    TrieNode* getNode(const char data) {
-        TrieNode* newNode = new TrieNode; 
-        
-        newNode->data = data;
-        newNode->leaf = false;
-        newNode->position = 0;
-        newNode->length = 0;
-        
-        for (int i = 0; i < ALPHABET_SIZE; i++) 
-            newNode->children[i] = nullptr;
-        
-        return newNode;
+    static const unsigned char* keys(const std::uint32_t* span) {
+        return reinterpret_cast<const unsigned char*>(span);
+    }
+
+    static unsigned char* keys(std::uint32_t* span) {
+        return reinterpret_cast<unsigned char*>(span);
     }
 
     /**
-    * Retorna um nodo raiz
+    * Posição de "key" entre as "count" chaves de um NODE_16, ou "count" se
+    * não estiver lá. Com SSE2, as 16 chaves são comparadas de uma vez
     */
-    TrieNode* getRoot() {
-        TrieNode* newNode = new TrieNode; 
-        
-        newNode->data = '\0';
-        newNode->leaf = false;
-        newNode->position = 0;
-        newNode->length = 0;
-        
-        for (int i = 0; i < ALPHABET_SIZE; i++) 
-            newNode->children[i] = nullptr; 
+    static unsigned find_key16(const unsigned char* stored, unsigned count, unsigned char key) {
+#ifdef __SSE2__
+        __m128i target = _mm_set1_epi8(static_cast<char>(key));
+        __m128i candidates = _mm_loadu_si128(reinterpret_cast<const __m128i*>(stored));
+        unsigned bits = _mm_movemask_epi8(_mm_cmpeq_epi8(target, candidates));
+        bits &= (1u << count) - 1;
+
+        return bits ? __builtin_ctz(bits) : count;
+#else
+        unsigned i = 0;
+        while (i < count && stored[i] != key)
+            i++;
 
-        return newNode;
+        return i;
+#endif
     }
 
+    Trie::Trie() {
+        getNode(*this, '\0');
+    }
+
+    TrieView::TrieView(const Trie& trie):
+        nodes{trie.nodes.data()},
+        node_count{trie.nodes.size()},
+        children{trie.children.data()},
+        children_count{trie.children.size()}
+    {}
+
+    TrieView::TrieView(const TrieNode* nodes, std::size_t node_count,
+                       const std::uint32_t* children, std::size_t children_count):
+        nodes{nodes},
+        node_count{node_count},
+        children{children},
+        children_count{children_count}
+    {}
+
     /**
-    * Insere uma chave na raiz da trie, com dado, posição e comprimento.
+    * Cria um nodo com filhos nulos e o dado recebido
     */
-    void insert(TrieNode* root, std::string key, std::size_t position, std::size_t length) {
-        TrieNode* crawlerNode = root;
+    std::uint32_t getNode(Trie& trie, const char data) {
+        TrieNode newNode;
 
-        for (std::size_t i = 0; i < key.length(); i++) {
-            int charIndex = key[i] - 'a';
-            
-            if (crawlerNode->children[charIndex] == nullptr) {
-                crawlerNode->children[charIndex] = getNode(key[i]);
+        // zera também os bytes de alinhamento, que são gravados no índice
+        std::memset(&newNode, 0, sizeof(newNode));
+
+        newNode.data = data;
+        newNode.leaf = false;
+        newNode.position = 0;
+        newNode.length = 0;
+        newNode.children = 0;
+        newNode.words = 0;
+        newNode.weight = 0;
+        newNode.max_weight = 0;
+        newNode.count = 0;
+        newNode.type = NODE_EMPTY;
+
+        trie.nodes.push_back(newNode);
+
+        return static_cast<std::uint32_t>(trie.nodes.size() - 1);
+    }
+
+    /**
+    * Retorna o índice do filho de "node" pelo byte "c", ou NO_NODE
+    */
+    std::uint32_t child(const TrieView& trie, std::uint32_t node, char c) {
+        const TrieNode& parent = trie.nodes[node];
+        const std::uint32_t* span = trie.children + parent.children;
+        unsigned char key = static_cast<unsigned char>(c);
+
+        switch (parent.type) {
+            case NODE_4:
+                for (unsigned i = 0; i < parent.count; i++)
+                    if (keys(span)[i] == key)
+                        return span[KEY_WORDS[NODE_4] + i];
+                return NO_NODE;
+
+            case NODE_16: {
+                unsigned i = find_key16(keys(span), parent.count, key);
+                return i < parent.count ? span[KEY_WORDS[NODE_16] + i] : NO_NODE;
+            }
+
+            case NODE_48: {
+                unsigned slot = keys(span)[key];
+                return slot ? span[KEY_WORDS[NODE_48] + slot - 1] : NO_NODE;
             }
-            
-            crawlerNode = crawlerNode->children[charIndex];
+
+            case NODE_256:
+                return span[key];
+
+            default:
+                return NO_NODE;
         }
-        
-        crawlerNode->leaf = true;
-        crawlerNode->position = position;
-        crawlerNode->length = length;
     }
 
     /**
-    * Verifica se uma dada chave está representada na Trie
+    * Retorna o próximo filho de "node", em ordem crescente de byte, a partir
+    * de "cursor" (que começa em 0 e é avançado), com seu byte em "key".
+    * Retorna NO_NODE quando não há mais filhos
     */
-    bool contains(TrieNode* root, std::string key) {
-        TrieNode* crawlerNode = root;
+    static std::uint32_t next_child(const TrieView& trie, const TrieNode& node,
+                                    std::uint32_t& cursor, unsigned char& key) {
+        const std::uint32_t* span = trie.children + node.children;
 
-        for (std::size_t i = 0; i < key.length(); i++) {
-            int charIndex = key[i] - 'a';
-            
-            if (crawlerNode->children[charIndex] == nullptr)
-                return false;
-            
-            crawlerNode = crawlerNode->children[charIndex];
+        switch (node.type) {
+            case NODE_4:
+            case NODE_16:
+                if (cursor >= node.count)
+                    return NO_NODE;
+                key = keys(span)[cursor];
+                return span[KEY_WORDS[node.type] + cursor++];
+
+            case NODE_48:
+                while (cursor < ALPHABET_SIZE) {
+                    unsigned slot = keys(span)[cursor++];
+                    if (slot) {
+                        key = static_cast<unsigned char>(cursor - 1);
+                        return span[KEY_WORDS[NODE_48] + slot - 1];
+                    }
+                }
+                return NO_NODE;
+
+            case NODE_256:
+                while (cursor < ALPHABET_SIZE) {
+                    std::uint32_t childNode = span[cursor++];
+                    if (childNode != NO_NODE) {
+                        key = static_cast<unsigned char>(cursor - 1);
+                        return childNode;
+                    }
+                }
+                return NO_NODE;
+
+            default:
+                return NO_NODE;
         }
-        
-        return (crawlerNode != nullptr && crawlerNode->leaf);
     }
 
     /**
-    * Conta a quantidade de palavras para qual a string "key" é prefixo
+    * Reserva um espaço zerado para um nó do tipo "type", reaproveitando um
+    * espaço descartado do mesmo tipo se houver
     */
-    TrieNode* get(TrieNode* root, std::string key) {
-        TrieNode* crawlerNode = root;
+    static std::uint32_t allocate_span(Trie& trie, unsigned type) {
+        unsigned size = KEY_WORDS[type] + CAPACITY[type];
+        std::vector<std::uint32_t>& reusable = trie.free_children[type];
 
-        for (std::size_t i = 0; i < key.length(); i++) {
-            int charIndex = key[i] - 'a';
-            
-            if (crawlerNode->children[charIndex] == nullptr)
-                return root;
-            
-            crawlerNode = crawlerNode->children[charIndex];
+        if (reusable.empty()) {
+            std::uint32_t span = static_cast<std::uint32_t>(trie.children.size());
+            trie.children.resize(trie.children.size() + size);
+            return span;
+        }
+
+        std::uint32_t span = reusable.back();
+        reusable.pop_back();
+        std::fill_n(trie.children.begin() + span, size, 0);
+
+        return span;
+    }
+
+    /**
+    * Coloca "newChild" no espaço de "node", que ainda tem lugar e não tem
+    * filho pelo byte "key". NODE_4 e NODE_16 mantêm as chaves em ordem
+    */
+    static void put_child(Trie& trie, std::uint32_t node, unsigned char key, std::uint32_t newChild) {
+        TrieNode& parent = trie.nodes[node];
+        std::uint32_t* span = trie.children.data() + parent.children;
+
+        switch (parent.type) {
+            case NODE_4:
+            case NODE_16: {
+                unsigned char* stored = keys(span);
+                std::uint32_t* slots = span + KEY_WORDS[parent.type];
+
+                unsigned position = parent.count;
+                while (position > 0 && stored[position - 1] > key) {
+                    stored[position] = stored[position - 1];
+                    slots[position] = slots[position - 1];
+                    position--;
+                }
+
+                stored[position] = key;
+                slots[position] = newChild;
+                break;
+            }
+
+            case NODE_48:
+                span[KEY_WORDS[NODE_48] + parent.count] = newChild;
+                keys(span)[key] = static_cast<unsigned char>(parent.count + 1);
+                break;
+
+            case NODE_256:
+                span[key] = newChild;
+                break;
         }
 
-        if ((crawlerNode != nullptr && crawlerNode->leaf)) {
-            return crawlerNode;
+        parent.count++;
+    }
+
+    /**
+    * Troca o espaço de "node", que está cheio, pelo do tipo seguinte,
+    * copiando os filhos. O espaço antigo fica disponível para outro nó
+    */
+    static void grow(Trie& trie, std::uint32_t node) {
+        TrieNode old = trie.nodes[node];
+        std::uint32_t span = allocate_span(trie, old.type + 1);
+
+        TrieNode& parent = trie.nodes[node];
+        parent.type = static_cast<std::uint8_t>(old.type + 1);
+        parent.children = span;
+        parent.count = 0;
+
+        TrieView view(trie);
+        std::uint32_t cursor = 0;
+        unsigned char key;
+        std::uint32_t childNode;
+        while ((childNode = next_child(view, old, cursor, key)) != NO_NODE)
+            put_child(trie, node, key, childNode);
+
+        if (old.type != NODE_EMPTY)
+            trie.free_children[old.type].push_back(old.children);
+    }
+
+    /**
+    * Liga "newChild" como filho de "node" pelo byte "key", que ainda não
+    * pode ter filho, trocando o nó por um tipo maior se estiver cheio
+    */
+    static void link_child(Trie& trie, std::uint32_t node, unsigned char key, std::uint32_t newChild) {
+        if (trie.nodes[node].count == CAPACITY[trie.nodes[node].type])
+            grow(trie, node);
+
+        put_child(trie, node, key, newChild);
+    }
+
+    /**
+    * Retorna o índice do filho de "node" pelo byte "c", criando-o caso não
+    * exista
+    */
+    std::uint32_t add_child(Trie& trie, std::uint32_t node, char c) {
+        std::uint32_t existing = child(trie, node, c);
+        if (existing != NO_NODE)
+            return existing;
+
+        std::uint32_t newChild = getNode(trie, c);
+        link_child(trie, node, static_cast<unsigned char>(c), newChild);
+
+        return newChild;
+    }
+
+    /**
+    * Soma "offset" aos índices dos filhos guardados no espaço de "node"
+    */
+    static void shift_children(Trie& trie, const TrieNode& node, std::uint32_t offset) {
+        std::uint32_t* slots = trie.children.data() + node.children + KEY_WORDS[node.type];
+
+        if (node.type == NODE_256) {
+            for (unsigned i = 0; i < ALPHABET_SIZE; i++)
+                if (slots[i] != NO_NODE)
+                    slots[i] += offset;
         } else {
-            return root;
+            for (unsigned i = 0; i < node.count; i++)
+                slots[i] += offset;
         }
     }
 
     /**
-    * Conta a quantidade de nós que finalizam uma palavra abaixo de um dado nó
+    * Copia os nós de "subtrie", exceto a raiz, para o fim dos vetores de
+    * "trie", deslocando os índices, e liga os filhos da raiz de "subtrie" à
+    * raiz de "trie"
     */
-    int count_leaf_children(TrieNode* root) {
-        int count = 0;
+    void attach(Trie& trie, const Trie& subtrie) {
+        const TrieNode& subroot = subtrie.nodes[0];
+        TrieView subview(subtrie);
 
-        for (std::size_t i = 0; i < ALPHABET_SIZE; i++) {
-            if (root->children[i] == nullptr) {
-                continue;
-            } else {
-                if (root->children[i]->leaf)
-                    count += 1;
-                
-                count += count_leaf_children(root->children[i]);
+        std::uint32_t cursor = 0;
+        unsigned char key;
+        std::uint32_t childNode;
+        while ((childNode = next_child(subview, subroot, cursor, key)) != NO_NODE)
+            if (child(trie, 0, static_cast<char>(key)) != NO_NODE)
+                throw std::invalid_argument("Subtrie shares first letters with trie");
+
+        // o nó i (i >= 1) de subtrie passa a ser o nó i + nodeOffset
+        std::uint32_t nodeOffset = static_cast<std::uint32_t>(trie.nodes.size() - 1);
+        std::uint32_t childrenOffset = static_cast<std::uint32_t>(trie.children.size());
+
+        trie.children.insert(trie.children.end(), subtrie.children.begin(), subtrie.children.end());
+
+        for (std::size_t i = 1; i < subtrie.nodes.size(); i++) {
+            TrieNode node = subtrie.nodes[i];
+            node.children += childrenOffset;
+
+            if (node.type != NODE_EMPTY)
+                shift_children(trie, node, nodeOffset);
+
+            trie.nodes.push_back(node);
+        }
+
+        // os espaços livres de subtrie continuam reaproveitáveis
+        for (unsigned type = 0; type < NODE_TYPES; type++)
+            for (std::uint32_t span : subtrie.free_children[type])
+                trie.free_children[type].push_back(span + childrenOffset);
+
+        cursor = 0;
+        while ((childNode = next_child(subview, subroot, cursor, key)) != NO_NODE)
+            link_child(trie, 0, key, childNode + nodeOffset);
+
+        trie.nodes[0].words += subroot.words;
+        trie.nodes[0].max_weight = std::max(trie.nodes[0].max_weight, subroot.max_weight);
+    }
+
+    /**
+    * Retorna o índice do nó ao final do percurso de "key", ou NO_NODE
+    */
+    static std::uint32_t find_node(const TrieView& trie, std::string_view key) {
+        std::uint32_t crawlerNode = 0;
+
+        for (std::size_t i = 0; i < key.length(); i++) {
+            crawlerNode = child(trie, crawlerNode, key[i]);
+
+            if (crawlerNode == NO_NODE)
+                return NO_NODE;
+        }
+
+        return crawlerNode;
+    }
+
+    /**
+    * Retorna o nó ao final do percurso de "key", ou nullptr
+    */
+    const TrieNode* find(const TrieView& trie, std::string_view key) {
+        std::uint32_t node = find_node(trie, key);
+
+        if (node == NO_NODE && !key.empty())
+            return nullptr;
+
+        return &trie.nodes[node];
+    }
+
+    /**
+    * Insere uma chave na raiz da trie, com dado, posição, comprimento e peso.
+    * Uma única descida cria os nós que faltam, incrementa o contador de
+    * palavras e atualiza o "max_weight" de cada nó do caminho, inclusive da
+    * raiz. Se a palavra já existia, os contadores são desfeitos numa segunda
+    * descida, que só acontece nesse caso. O "max_weight" só cresce: se o peso
+    * de uma palavra diminuir, ele continua sendo um limite superior válido
+    */
+    void insert(Trie& trie, std::string_view key, std::size_t position, std::size_t length,
+                std::uint32_t weight) {
+        std::uint32_t crawlerNode = 0;
+        trie.nodes[crawlerNode].words++;
+        trie.nodes[crawlerNode].max_weight = std::max(trie.nodes[crawlerNode].max_weight, weight);
+
+        for (std::size_t i = 0; i < key.length(); i++) {
+            // add_child pode realocar "nodes": o nó é acessado pelo índice
+            crawlerNode = add_child(trie, crawlerNode, key[i]);
+            trie.nodes[crawlerNode].words++;
+            trie.nodes[crawlerNode].max_weight = std::max(trie.nodes[crawlerNode].max_weight, weight);
+        }
+
+        TrieNode& node = trie.nodes[crawlerNode];
+
+        // Palavra repetida só atualiza os dados
+        if (node.leaf) {
+            std::uint32_t rollback = 0;
+            trie.nodes[rollback].words--;
+            for (std::size_t i = 0; i < key.length(); i++) {
+                rollback = child(trie, rollback, key[i]);
+                trie.nodes[rollback].words--;
             }
         }
 
-        return count;
+        node.leaf = true;
+        node.position = position;
+        node.length = static_cast<std::uint32_t>(length);
+        node.weight = weight;
+    }
+
+    /**
+    * Verifica se uma dada chave está representada na Trie
+    */
+    bool contains(const TrieView& trie, std::string_view key) {
+        std::uint32_t node = find_node(trie, key);
+
+        // a chave vazia termina na própria raiz
+        return (node != NO_NODE || key.empty()) && trie.nodes[node].leaf;
     }
 
     /**
     * Retorna o último nó do percurso de uma chave. Exemplo: na chave "stock", retorna
     * o nó correspondente ao caractere "k"
     */
-    int prefix_count(TrieNode* root, std::string key) {
-        TrieNode* crawlerNode = root;
-        int count = 0;
+    const TrieNode* get(const TrieView& trie, std::string_view key) {
+        std::uint32_t node = find_node(trie, key);
 
-        for (std::size_t i = 0; i < key.length(); i++) {
-            int charIndex = key[i] - 'a';
-            
-            if (crawlerNode->children[charIndex] == nullptr)
-                return 0;
-            
-            crawlerNode = crawlerNode->children[charIndex];
+        if (trie.nodes[node].leaf) {
+            return &trie.nodes[node];
+        } else {
+            return &trie.nodes[0];
         }
+    }
 
-        if (crawlerNode->leaf)
-            count += 1;
+    /**
+    * Conta a quantidade de palavras para qual a string "key" é prefixo
+    */
+    int prefix_count(const TrieView& trie, std::string_view key) {
+        std::uint32_t node = find_node(trie, key);
+
+        if (node == NO_NODE && !key.empty())
+            return 0;
 
-        return count + count_leaf_children(crawlerNode);
+        return static_cast<int>(trie.nodes[node].words);
     }
 
-}  // namespace trie
+    /**
+    * Limpa os resultados de "out" e, caso "prefix" exista na trie, retorna
+    * seu nó em "node"
+    */
+    static bool start_completions(const TrieView& trie, std::string_view prefix,
+                                  Completions& out, std::uint32_t& node) {
+        out.words.clear();
+        out.nodes.clear();
+        out.buffer.clear();
+        out.ends.clear();
+
+        node = find_node(trie, prefix);
+        return node != NO_NODE || prefix.empty();
+    }
+
+    /**
+    * Cria os string_views de "out.words" a partir das palavras concatenadas
+    * em "out.buffer", que não muda mais até a próxima consulta
+    */
+    static std::size_t finish_completions(Completions& out) {
+        std::size_t begin = 0;
+
+        for (std::size_t end : out.ends) {
+            out.words.emplace_back(out.buffer.data() + begin, end - begin);
+            begin = end;
+        }
+
+        return out.words.size();
+    }
 
-#endif
\ No newline at end of file
+    /**
+    * Percorre a subárvore de "prefix" em pré-ordem. Como os filhos são
+    * visitados em ordem crescente de byte e uma palavra vem antes das que a
+    * estendem, as palavras aparecem em ordem de bytes: a alfabética para
+    * letras minúsculas e a de code points para UTF-8. A pilha guarda, para
+    * cada nó do caminho atual, o cursor de next_child
+    */
+    std::size_t complete(const TrieView& trie, std::string_view prefix,
+                         std::size_t k, Completions& out) {
+        std::uint32_t node;
+        if (!start_completions(trie, prefix, out, node) || k == 0)
+            return 0;
+
+        out.path.assign(prefix.data(), prefix.size());
+        out.stack.clear();
+        out.stack.push_back({node, 0});
+
+        if (trie.nodes[node].leaf) {
+            out.buffer += out.path;
+            out.ends.push_back(out.buffer.size());
+            out.nodes.push_back(&trie.nodes[node]);
+        }
+
+        while (!out.stack.empty() && out.nodes.size() < k) {
+            Completions::Frame& frame = out.stack.back();
+            const TrieNode& parent = trie.nodes[frame.node];
+
+            unsigned char key;
+            std::uint32_t childNode = next_child(trie, parent, frame.next, key);
+
+            if (childNode == NO_NODE) {
+                out.stack.pop_back();
+                if (!out.stack.empty())
+                    out.path.pop_back();
+                continue;
+            }
+
+            const TrieNode& current = trie.nodes[childNode];
+            out.path.push_back(current.data);
+            out.stack.push_back({childNode, 0});
+
+            if (current.leaf) {
+                out.buffer += out.path;
+                out.ends.push_back(out.buffer.size());
+                out.nodes.push_back(&current);
+            }
+        }
+
+        return finish_completions(out);
+    }
+
+    /**
+    * Ordem do heap de candidatos: maior peso primeiro; no empate, palavras
+    * antes de subárvores e, entre elas, a descoberta primeiro
+    */
+    static bool lower_priority(const Completions::Candidate& a, const Completions::Candidate& b) {
+        if (a.weight != b.weight)
+            return a.weight < b.weight;
+        if (a.word != b.word)
+            return b.word;
+        return a.step > b.step;
+    }
+
+    /**
+    * Busca pela melhor opção. O heap guarda subárvores, com prioridade
+    * "max_weight", e palavras, com prioridade "weight". Quando uma palavra
+    * sai do heap, nenhuma outra pendente pode ter peso maior, então ela é o
+    * próximo resultado. Subárvores com limite abaixo dos "k" resultados nunca
+    * chegam a sair do heap. "steps" guarda o pai de cada nó visitado, para
+    * remontar as palavras sem copiar o caminho a cada passo
+    */
+    std::size_t complete_ranked(const TrieView& trie, std::string_view prefix,
+                                std::size_t k, Completions& out) {
+        std::uint32_t node;
+        if (!start_completions(trie, prefix, out, node) || k == 0)
+            return 0;
+
+        const std::uint32_t NO_STEP = UINT32_MAX;
+        out.steps.clear();
+        out.heap.clear();
+
+        out.steps.push_back({node, NO_STEP});
+        out.heap.push_back({trie.nodes[node].max_weight, 0, false});
+
+        while (!out.heap.empty() && out.nodes.size() < k) {
+            std::pop_heap(out.heap.begin(), out.heap.end(), lower_priority);
+            Completions::Candidate candidate = out.heap.back();
+            out.heap.pop_back();
+
+            const TrieNode& current = trie.nodes[out.steps[candidate.step].node];
+
+            if (candidate.word) {
+                // remonta a palavra de trás para frente a partir do nó
+                out.path.clear();
+                for (std::uint32_t step = candidate.step; out.steps[step].parent != NO_STEP;
+                     step = out.steps[step].parent)
+                    out.path.push_back(trie.nodes[out.steps[step].node].data);
+
+                out.buffer.append(prefix.data(), prefix.size());
+                out.buffer.append(out.path.rbegin(), out.path.rend());
+                out.ends.push_back(out.buffer.size());
+                out.nodes.push_back(&current);
+                continue;
+            }
+
+            if (current.leaf) {
+                out.heap.push_back({current.weight, candidate.step, true});
+                std::push_heap(out.heap.begin(), out.heap.end(), lower_priority);
+            }
+
+            std::uint32_t cursor = 0;
+            unsigned char key;
+            std::uint32_t childNode;
+            while ((childNode = next_child(trie, current, cursor, key)) != NO_NODE) {
+                std::uint32_t step = static_cast<std::uint32_t>(out.steps.size());
+
+                out.steps.push_back({childNode, candidate.step});
+                out.heap.push_back({trie.nodes[childNode].max_weight, step, false});
+                std::push_heap(out.heap.begin(), out.heap.end(), lower_priority);
+            }
+        }
+
+        return finish_completions(out);
+    }
+
+}  // namespace trie
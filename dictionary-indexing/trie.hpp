@@ -1,4 +1,13 @@
-#define ALPHABET_SIZE 26
+#ifndef TRIE_TRIE_HPP
+#define TRIE_TRIE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#define ALPHABET_SIZE 256
 
 /**
  * 
@@ -8,51 +17,180 @@
 namespace trie {
 
     /**
-     * @brief Struct que contém os dados do TrieNode
+     * @brief Tipos de nó, conforme a quantidade de filhos, como na Adaptive
+     * Radix Tree. As chaves são bytes, então palavras em UTF-8 funcionam sem
+     * nós de 256 filhos para todo caractere. Cada tipo guarda seus filhos em
+     * um espaço de Trie::children com um formato próprio:
+     * NODE_EMPTY: sem filhos e sem espaço;
+     * NODE_4 e NODE_16: 4 ou 16 bytes de chave, em ordem crescente, seguidos
+     * dos índices dos filhos na mesma ordem;
+     * NODE_48: 256 bytes que dão, para cada byte, 1 + a posição do filho (0
+     * se não houver), seguidos de 48 índices;
+     * NODE_256: 256 índices, um por byte (NO_NODE se não houver filho).
+    */
+    enum NodeType : std::uint8_t {
+        NODE_EMPTY,
+        NODE_4,
+        NODE_16,
+        NODE_48,
+        NODE_256,
+        NODE_TYPES
+    };
+
+    /**
+     * @brief Struct que contém os dados do TrieNode. Os filhos não são
+     * ponteiros: "children" é a posição, em Trie::children, do espaço com os
+     * filhos, cujo formato depende de "type", e "count" é a quantidade de
+     * filhos. Um nó cresce para o tipo seguinte quando o espaço enche.
+     * "words" é a quantidade de palavras que passam pelo nó, ou seja, para
+     * as quais o caminho até ele é prefixo. "weight" é o peso da palavra que
+     * termina no nó e "max_weight" é um limite superior dos pesos das
+     * palavras da subárvore, usado para podar a busca das completações de
+     * maior peso.
     */
     struct TrieNode {
+        std::uint64_t position;
+        std::uint32_t length;
+        std::uint32_t children;
+        std::uint32_t words;
+        std::uint32_t weight;
+        std::uint32_t max_weight;
+        std::uint16_t count;
+        std::uint8_t type;
         char data;
-        unsigned long position;
-        unsigned long length;
-        struct TrieNode *children[ALPHABET_SIZE];
         bool leaf;
     };
 
+    /**
+     * @brief Trie dona de todos os seus nós, guardados em um único vetor e
+     * referenciados por índices de 32 bits. A raiz é sempre o nó 0. A memória
+     * é liberada junto com a Trie.
+    */
+    struct Trie {
+        Trie();
+
+        std::vector<TrieNode> nodes;
+        std::vector<std::uint32_t> children;
+        /// Posições de espaços de filhos descartados, por tipo, para reuso
+        std::vector<std::uint32_t> free_children[NODE_TYPES];
+    };
+
+    /**
+     * @brief Visão somente leitura dos vetores de uma Trie. As consultas
+     * operam sobre ela, de modo que funcionam tanto sobre uma Trie em memória
+     * quanto sobre um índice mapeado do disco (ver index.hpp).
+    */
+    struct TrieView {
+        TrieView(const Trie& trie);  // NOLINT(runtime/explicit)
+        TrieView(const TrieNode* nodes, std::size_t node_count,
+                 const std::uint32_t* children, std::size_t children_count);
+
+        const TrieNode* nodes;
+        std::size_t node_count;
+        const std::uint32_t* children;
+        std::size_t children_count;
+    };
+
+    /**
+     * @brief Resultado de complete() e complete_ranked(). As palavras ficam
+     * concatenadas em "buffer" e "words" aponta para elas; "nodes" tem o nó
+     * de cada palavra. Os vetores são reaproveitados entre consultas, então
+     * os resultados valem até a próxima consulta com o mesmo objeto.
+    */
+    struct Completions {
+        std::vector<std::string_view> words;
+        std::vector<const TrieNode*> nodes;
+        std::string buffer;
+
+        /// Estado da busca, mantido aqui só para reaproveitar a memória
+        struct Frame { std::uint32_t node; std::uint32_t next; };
+        struct Step { std::uint32_t node; std::uint32_t parent; };
+        struct Candidate { std::uint32_t weight; std::uint32_t step; bool word; };
+        std::string path;
+        std::vector<std::size_t> ends;
+        std::vector<Frame> stack;
+        std::vector<Step> steps;
+        std::vector<Candidate> heap;
+    };
+
+    /**
+     * @brief Índice que indica ausência de filho. Como a raiz nunca é filha
+     * de outro nó, o índice 0 pode ser usado para isso.
+    */
+    const std::uint32_t NO_NODE = 0;
+
     /**
      * 
-     * @brief Retorna um nodo com filhos nulos e o dado recebido.
+     * @brief Cria um nodo sem filhos com o dado recebido e retorna seu índice.
      * 
     */
-    TrieNode* getNode(const char data);
+    std::uint32_t getNode(Trie& trie, const char data);
+
+    /**
+    * @brief Retorna o índice do filho de "node" pelo byte "c", ou NO_NODE
+    */
+    std::uint32_t child(const TrieView& trie, std::uint32_t node, char c);
+
+    /**
+    * @brief Retorna o índice do filho de "node" pelo byte "c", criando-o
+    * caso não exista
+    */
+    std::uint32_t add_child(Trie& trie, std::uint32_t node, char c);
 
     /**
-    * @brief Retorna um nodo raiz
+    * @brief Anexa à raiz de "trie" os filhos da raiz de "subtrie", copiando
+    * seus nós. As duas raízes não podem ter filhos pelo mesmo byte. Usado
+    * para juntar tries construídas separadamente (ver loader.hpp)
     */
-    TrieNode* getRoot();
+    void attach(Trie& trie, const Trie& subtrie);
 
     /**
-    * @brief Insere uma chave na raiz da trie, com dado, posição e comprimento.
+    * @brief Insere uma chave na raiz da trie, com dado, posição, comprimento
+    * e peso. Reinserir uma palavra substitui seu peso.
     */
-    void insert(TrieNode* root, std::string key, size_t position, size_t length);
+    void insert(Trie& trie, std::string_view key, size_t position, size_t length,
+                std::uint32_t weight = 0);
 
     /**
     * @brief Verifica se uma dada chave está representada na Trie
     */
-    bool contains(TrieNode* root, std::string key);
+    bool contains(const TrieView& trie, std::string_view key);
 
     /**
-    * @brief Conta a quantidade de palavras para qual a string "key" é prefixo
+    * @brief Conta a quantidade de palavras para qual a string "key" é prefixo,
+    * em tempo proporcional ao tamanho de "key"
     */
-    int prefix_count(TrieNode* root, std::string key);
+    int prefix_count(const TrieView& trie, std::string_view key);
 
     /**
-    * @brief Conta a quantidade de nós que finalizam uma palavra abaixo de um dado nó
+    * @brief Retorna o nó ao final do percurso de "key", ou nullptr se o
+    * percurso não existir. Com ele, uma única descida responde se "key" é
+    * prefixo (words > 0) e se é palavra (leaf)
     */
-    int count_leaf_children(TrieNode* root);
+    const TrieNode* find(const TrieView& trie, std::string_view key);
 
     /**
     * @brief Retorna o último nó do percurso de uma chave. Exemplo: na chave "stock", retorna
-    * o nó correspondente ao caractere "k"
+    * o nó correspondente ao caractere "k". Caso a chave não esteja na Trie, retorna a raiz
+    */
+    const TrieNode* get(const TrieView& trie, std::string_view key);
+
+    /**
+    * @brief Coloca em "out" as "k" primeiras palavras, em ordem de bytes,
+    * que têm "prefix" como prefixo. A busca para assim que encontra "k"
+    * palavras. Retorna a quantidade encontrada
     */
-    TrieNode* get(TrieNode* root, std::string key);
-}  // namespace trie
\ No newline at end of file
+    std::size_t complete(const TrieView& trie, std::string_view prefix,
+                         std::size_t k, Completions& out);
+
+    /**
+    * @brief Coloca em "out" as "k" palavras de maior peso que têm "prefix"
+    * como prefixo, em ordem decrescente de peso. Subárvores cujo
+    * "max_weight" não supera os resultados já encontrados não são visitadas.
+    * Retorna a quantidade encontrada
+    */
+    std::size_t complete_ranked(const TrieView& trie, std::string_view prefix,
+                                std::size_t k, Completions& out);
+}  // namespace trie
+
+#endif
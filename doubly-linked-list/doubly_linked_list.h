@@ -2,8 +2,14 @@
 #ifndef STRUCTURES_LINKED_LIST_H
 #define STRUCTURES_LINKED_LIST_H
 
+#include <cstddef>
 #include <cstdint>
+#include <iterator>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "node_pool.h"
 
 namespace structures {
 
@@ -42,11 +48,69 @@ class Node {
 };
 
 //! Classe DoublyLinkedList, implementa uma estrutura de dados
-//! com encadeamento simples, que permite ao programador
-//! manipular listas com quantidades não determinadas de elementos
-template<typename T>
+//! com encadeamento duplo, que permite ao programador
+//! manipular listas com quantidades não determinadas de elementos.
+//! Os Nodes são obtidos de [Allocator]; o padrão é um NodePool, que
+//! reaproveita Nodes removidos e permite que clear() libere a lista
+//! inteira de uma vez
+template<typename T, typename Allocator = NodePool<Node<T>>>
 class DoublyLinkedList {
  public:
+    //! Iterador bidirecional sobre os elementos da lista, [U] é T ou
+    //! const T
+    template<typename U>
+    class Iterator {
+     public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = U*;
+        using reference = U&;
+
+        //! Construtor padrão, iterador que não aponta para nenhuma lista
+        Iterator() = default;
+        //! Conversão de iterator para const_iterator; a conversão
+        //! contrária não existe, pois permitiria alterar uma lista const
+        template<typename V, typename = typename std::enable_if<
+            std::is_const<U>::value && !std::is_const<V>::value>::type>
+        Iterator(const Iterator<V>& other);  // NOLINT(runtime/explicit)
+        //! Acessa o elemento apontado
+        reference operator*() const;
+        //! Acessa um membro do elemento apontado
+        pointer operator->() const;
+        //! Avança para o próximo elemento
+        Iterator& operator++();
+        //! Avança para o próximo elemento (pós-fixado)
+        Iterator operator++(int);
+        //! Volta para o elemento anterior; a partir de end() vai à cauda
+        Iterator& operator--();
+        //! Volta para o elemento anterior (pós-fixado)
+        Iterator operator--(int);
+        //! Compara a posição de dois iteradores, const ou não
+        template<typename V>
+        bool operator==(const Iterator<V>& other) const;
+        //! Compara a posição de dois iteradores, const ou não
+        template<typename V>
+        bool operator!=(const Iterator<V>& other) const;
+
+     private:
+        friend class DoublyLinkedList;
+        template<typename V>
+        friend class Iterator;
+
+        Iterator(Node<T>* node, const DoublyLinkedList* list);
+
+        //! Node apontado, nullptr representa end()
+        Node<T>* node_{nullptr};
+        //! Lista percorrida, usada para voltar de end() até a cauda
+        const DoublyLinkedList* list_{nullptr};
+    };
+
+    using iterator = Iterator<T>;
+    using const_iterator = Iterator<const T>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
     //! Construtor padrão de DoublyLinkedList
     DoublyLinkedList();
     //! Destrutor padrão de DoublyLinkedList
@@ -59,6 +123,9 @@ class DoublyLinkedList {
     void push_front(const T& data);
     //! Insere elemento na posição [index] da lista
     void insert(const T& data, std::size_t index);
+    //! Insere elemento antes da posição [position], em O(1).
+    //! Retorna um iterador para o elemento inserido
+    iterator insert(const_iterator position, const T& data);
     //! Insere elemento mantendo a ordenação da lista
     void insert_sorted(const T& data);
     //! Acessa o elemento na posição [index] da lista
@@ -69,6 +136,9 @@ class DoublyLinkedList {
     T pop_back();
     //! Retira o elemento do início da lista
     T pop_front();
+    //! Remove o elemento na posição [position], em O(1).
+    //! Retorna um iterador para o elemento seguinte
+    iterator erase(const_iterator position);
     //! Remove um elemento que contenha os dados em [data]
     void remove(const T& data);
     //! Verifica se a lista está vazia
@@ -83,15 +153,45 @@ class DoublyLinkedList {
     //! utilize []
     T& operator[](std::size_t index);
 
+    //! Iterador para o primeiro elemento
+    iterator begin();
+    //! Iterador para o primeiro elemento
+    const_iterator begin() const;
+    //! Iterador para depois do último elemento
+    iterator end();
+    //! Iterador para depois do último elemento
+    const_iterator end() const;
+    //! Iterador reverso para o último elemento
+    reverse_iterator rbegin();
+    //! Iterador reverso para o último elemento
+    const_reverse_iterator rbegin() const;
+    //! Iterador reverso para antes do primeiro elemento
+    reverse_iterator rend();
+    //! Iterador reverso para antes do primeiro elemento
+    const_reverse_iterator rend() const;
+
  private:
-    //! Retorna o Node que está no índice [index] da lista
+    //! Retorna o Node que está no índice [index] da lista, percorrendo
+    //! a partir da cabeça ou da cauda, a que estiver mais próxima
     Node<T>* node_at(std::size_t index);
+    //! Cria um Node com [data] e o encadeia antes de [next]
+    //! (nullptr insere no fim)
+    Node<T>* link_before(Node<T>* next, const T& data);
+    //! Desencadeia [node] da lista, sem destruí-lo
+    void unlink(Node<T>* node);
     //! Ponteiro para Node que é a cabeça da lista
     structures::Node<T>* head{nullptr};
     //! Ponteiro para Node que é a cauda da lista
     structures::Node<T>* tail{nullptr};
     //! Tamanho atual da lista
     std::size_t size_{0u};
+    //! Alocador dos Nodes da lista
+    Allocator allocator_;
+    //! Constrói um Node com memória obtida de allocator_
+    template<typename... Args>
+    Node<T>* create_node(Args&&... args);
+    //! Destrói um Node e devolve sua memória a allocator_
+    void destroy_node(Node<T>* node);
 };
 
 }  // namespace structures
@@ -160,130 +260,215 @@ void structures::Node<T>::prev(Node<T>* prev) {
     prev_ = prev;
 }
 
+// Implementações de DoublyLinkedList::Iterator
+
+template<typename T, typename Allocator>
+template<typename U>
+structures::DoublyLinkedList<T, Allocator>::Iterator<U>::Iterator(
+    Node<T>* node,
+    const DoublyLinkedList* list
+):
+    node_{node},
+    list_{list}
+{}
+
+template<typename T, typename Allocator>
+template<typename U>
+template<typename V, typename>
+structures::DoublyLinkedList<T, Allocator>::Iterator<U>::Iterator(
+    const Iterator<V>& other
+):
+    node_{other.node_},
+    list_{other.list_}
+{}
+
+template<typename T, typename Allocator>
+template<typename U>
+U& structures::DoublyLinkedList<T, Allocator>::Iterator<U>::operator*() const {
+    return node_->data();
+}
+
+template<typename T, typename Allocator>
+template<typename U>
+U* structures::DoublyLinkedList<T, Allocator>::Iterator<U>::operator->() const {
+    return &node_->data();
+}
+
+template<typename T, typename Allocator>
+template<typename U>
+typename structures::DoublyLinkedList<T, Allocator>::template Iterator<U>&
+structures::DoublyLinkedList<T, Allocator>::Iterator<U>::operator++() {
+    node_ = node_->next();
+    return *this;
+}
+
+template<typename T, typename Allocator>
+template<typename U>
+typename structures::DoublyLinkedList<T, Allocator>::template Iterator<U>
+structures::DoublyLinkedList<T, Allocator>::Iterator<U>::operator++(int) {
+    Iterator copy = *this;
+    ++*this;
+    return copy;
+}
+
+template<typename T, typename Allocator>
+template<typename U>
+typename structures::DoublyLinkedList<T, Allocator>::template Iterator<U>&
+structures::DoublyLinkedList<T, Allocator>::Iterator<U>::operator--() {
+    node_ = node_ == nullptr ? list_->tail : node_->prev();
+    return *this;
+}
+
+template<typename T, typename Allocator>
+template<typename U>
+typename structures::DoublyLinkedList<T, Allocator>::template Iterator<U>
+structures::DoublyLinkedList<T, Allocator>::Iterator<U>::operator--(int) {
+    Iterator copy = *this;
+    --*this;
+    return copy;
+}
+
+template<typename T, typename Allocator>
+template<typename U>
+template<typename V>
+bool structures::DoublyLinkedList<T, Allocator>::Iterator<U>::operator==(
+    const Iterator<V>& other
+) const {
+    return node_ == other.node_;
+}
+
+template<typename T, typename Allocator>
+template<typename U>
+template<typename V>
+bool structures::DoublyLinkedList<T, Allocator>::Iterator<U>::operator!=(
+    const Iterator<V>& other
+) const {
+    return node_ != other.node_;
+}
+
 // Implementações de DoublyLinkedList
 
-template<typename T>
-structures::DoublyLinkedList<T>::DoublyLinkedList() {}
+template<typename T, typename Allocator>
+structures::DoublyLinkedList<T, Allocator>::DoublyLinkedList() {}
 
-template<typename T>
-structures::DoublyLinkedList<T>::~DoublyLinkedList() {
+template<typename T, typename Allocator>
+structures::DoublyLinkedList<T, Allocator>::~DoublyLinkedList() {
     clear();
 }
 
-template<typename T>
-void structures::DoublyLinkedList<T>::clear() {
-    // inicializa o último elemento excluido como o head
-    auto last = head;
-
-    // pega o próximo elemento a ser excluido a partir de last->next()
-    // remove o elemento sendo excluido atualmente
-    // itera até acabarem os elementos
-    for (std::size_t i = 0; i < size(); i++) {
-        auto next = last->next();
-        delete last;
-        last = next;
+template<typename T, typename Allocator>
+void structures::DoublyLinkedList<T, Allocator>::clear() {
+    // quando o alocador libera tudo em bloco e os dados não precisam de
+    // destrutor, não é necessário percorrer a lista
+    if (!Allocator::releases_all || !std::is_trivially_destructible<T>::value) {
+        // inicializa o último elemento excluido como o head
+        auto last = head;
+
+        // pega o próximo elemento a ser excluido a partir de last->next()
+        // remove o elemento sendo excluido atualmente
+        // itera até acabarem os elementos
+        for (std::size_t i = 0; i < size(); i++) {
+            auto next = last->next();
+            destroy_node(last);
+            last = next;
+        }
     }
 
-    // seta o head como o ponteiro nulo e o tamanho como 0
+    allocator_.release();
+
+    // seta head e tail como o ponteiro nulo e o tamanho como 0
     head = nullptr;
+    tail = nullptr;
     size_ = 0;
 }
 
-template<typename T>
-void structures::DoublyLinkedList<T>::push_back(const T& data) {
-    insert(data, size());
+template<typename T, typename Allocator>
+void structures::DoublyLinkedList<T, Allocator>::push_back(const T& data) {
+    link_before(nullptr, data);
 }
 
-template<typename T>
-void structures::DoublyLinkedList<T>::push_front(const T& data) {
-    structures::Node<T>* new_node = new structures::Node<T>(data, head);
-
-    if (new_node == nullptr) {
-        throw(std::out_of_range("List is full (out of memory space)"));
-    } else {
-        if (head != nullptr) {
-            head->prev(new_node);
-        }
-        head = new_node;
-        size_++;
-    }
+template<typename T, typename Allocator>
+void structures::DoublyLinkedList<T, Allocator>::push_front(const T& data) {
+    link_before(head, data);
 }
 
-template<typename T>
-void structures::DoublyLinkedList<T>::insert(const T& data, std::size_t index) {
-    if (index < 0 || index > size()) {
+template<typename T, typename Allocator>
+void structures::DoublyLinkedList<T, Allocator>::insert(
+    const T& data,
+    std::size_t index
+) {
+    if (index > size()) {
         throw std::out_of_range("Invalid index");
     }
 
-    if (index == 0) {
-        push_front(data);
-    } else {
-        auto before = node_at(index - 1);
-        auto new_node = new structures::Node<T>(data, nullptr, before->next());
-        before->next(new_node);
-        size_++;
-    }
+    link_before(index == size() ? nullptr : node_at(index), data);
 }
 
-template<typename T>
-void structures::DoublyLinkedList<T>::insert_sorted(const T& data) {
-    // Inicializa node como a primeira posição da lista (head)
-    auto node = head;
+template<typename T, typename Allocator>
+typename structures::DoublyLinkedList<T, Allocator>::iterator
+structures::DoublyLinkedList<T, Allocator>::insert(
+    const_iterator position,
+    const T& data
+) {
+    return iterator(link_before(position.node_, data), this);
+}
 
-    // Itera sobre os elementos checando por ordenação
-    for (std::size_t i = 0; i < size(); i++) {
-        if (data <= node->data()) {
-            insert(data, i);
-            return;
-        }
+template<typename T, typename Allocator>
+void structures::DoublyLinkedList<T, Allocator>::insert_sorted(const T& data) {
+    // Procura o primeiro elemento maior ou igual a data e insere antes
+    // dele; se não houver, o elemento deve ser o último
+    auto node = head;
+    while (node != nullptr && data > node->data())
         node = node->next();
-    }
 
-    // Caso não encontre a ordenação até aqui, o elemento deve ser o último
-    push_back(data);
+    link_before(node, data);
 }
 
-template<typename T>
-T structures::DoublyLinkedList<T>::pop(std::size_t index) {
-    if (index < 0 || index >= size())
+template<typename T, typename Allocator>
+T structures::DoublyLinkedList<T, Allocator>::pop(std::size_t index) {
+    if (index >= size())
         throw std::out_of_range("Invalid index");
 
     if (empty())
         throw std::out_of_range("List is already empty");
 
-    if (index == 0) {
-        return pop_front();
-    } else {
-        structures::Node<T>* before = node_at(index - 1);
-        structures::Node<T>* removed_node = before->next();
-        before->next(removed_node->next());
-        T data = removed_node->data();
-        size_--;
-        delete removed_node;
-        return data;
-    }
+    structures::Node<T>* removed_node = node_at(index);
+    unlink(removed_node);
+    T data = removed_node->data();
+    destroy_node(removed_node);
+    return data;
 }
 
-template<typename T>
-T structures::DoublyLinkedList<T>::pop_back() {
-    return pop(size() -1 );
+template<typename T, typename Allocator>
+T structures::DoublyLinkedList<T, Allocator>::pop_back() {
+    if (empty())
+        throw std::out_of_range("List is empty");
+
+    return pop(size() - 1);
 }
 
-template<typename T>
-T structures::DoublyLinkedList<T>::pop_front() {
+template<typename T, typename Allocator>
+T structures::DoublyLinkedList<T, Allocator>::pop_front() {
     if (empty())
         throw std::out_of_range("List is empty");
 
-    structures::Node<T>* removed_node = head;
-    T data = removed_node->data();
-    head = head->next();
-    size_--;
-    delete removed_node;
-    return data;
+    return pop(0);
 }
 
-template<typename T>
-std::size_t structures::DoublyLinkedList<T>::find(const T& data) const {
+template<typename T, typename Allocator>
+typename structures::DoublyLinkedList<T, Allocator>::iterator
+structures::DoublyLinkedList<T, Allocator>::erase(const_iterator position) {
+    structures::Node<T>* removed_node = position.node_;
+    structures::Node<T>* next = removed_node->next();
+    unlink(removed_node);
+    destroy_node(removed_node);
+    return iterator(next, this);
+}
+
+template<typename T, typename Allocator>
+std::size_t structures::DoublyLinkedList<T, Allocator>::find(
+    const T& data
+) const {
     // começa a busca pelo primeiro elemento da lista
     auto node = head;
     // itera comparando o valor recebido de data com o data de cada elemento
@@ -299,50 +484,155 @@ std::size_t structures::DoublyLinkedList<T>::find(const T& data) const {
     return size();
 }
 
-template<typename T>
-void structures::DoublyLinkedList<T>::remove(const T& data) {
+template<typename T, typename Allocator>
+void structures::DoublyLinkedList<T, Allocator>::remove(const T& data) {
     pop(find(data));
 }
 
-template<typename T>
-bool structures::DoublyLinkedList<T>::empty() const {
+template<typename T, typename Allocator>
+bool structures::DoublyLinkedList<T, Allocator>::empty() const {
     return size() == 0;
 }
 
-template<typename T>
-bool structures::DoublyLinkedList<T>::contains(const T& data) const {
+template<typename T, typename Allocator>
+bool structures::DoublyLinkedList<T, Allocator>::contains(const T& data) const {
     return find(data) != size();
 }
 
-template<typename T>
-std::size_t structures::DoublyLinkedList<T>::size() const {
+template<typename T, typename Allocator>
+std::size_t structures::DoublyLinkedList<T, Allocator>::size() const {
     return size_;
 }
 
-template<typename T>
-T& structures::DoublyLinkedList<T>::at(std::size_t index) {
+template<typename T, typename Allocator>
+T& structures::DoublyLinkedList<T, Allocator>::at(std::size_t index) {
     return node_at(index)->data();
 }
 
-template<typename T>
-T& structures::DoublyLinkedList<T>::operator[](std::size_t index) {
+template<typename T, typename Allocator>
+T& structures::DoublyLinkedList<T, Allocator>::operator[](std::size_t index) {
     return at(index);
 }
 
-template<typename T>
-structures::Node<T>* structures::DoublyLinkedList<T>::node_at(
+template<typename T, typename Allocator>
+typename structures::DoublyLinkedList<T, Allocator>::iterator
+structures::DoublyLinkedList<T, Allocator>::begin() {
+    return iterator(head, this);
+}
+
+template<typename T, typename Allocator>
+typename structures::DoublyLinkedList<T, Allocator>::const_iterator
+structures::DoublyLinkedList<T, Allocator>::begin() const {
+    return const_iterator(head, this);
+}
+
+template<typename T, typename Allocator>
+typename structures::DoublyLinkedList<T, Allocator>::iterator
+structures::DoublyLinkedList<T, Allocator>::end() {
+    return iterator(nullptr, this);
+}
+
+template<typename T, typename Allocator>
+typename structures::DoublyLinkedList<T, Allocator>::const_iterator
+structures::DoublyLinkedList<T, Allocator>::end() const {
+    return const_iterator(nullptr, this);
+}
+
+template<typename T, typename Allocator>
+typename structures::DoublyLinkedList<T, Allocator>::reverse_iterator
+structures::DoublyLinkedList<T, Allocator>::rbegin() {
+    return reverse_iterator(end());
+}
+
+template<typename T, typename Allocator>
+typename structures::DoublyLinkedList<T, Allocator>::const_reverse_iterator
+structures::DoublyLinkedList<T, Allocator>::rbegin() const {
+    return const_reverse_iterator(end());
+}
+
+template<typename T, typename Allocator>
+typename structures::DoublyLinkedList<T, Allocator>::reverse_iterator
+structures::DoublyLinkedList<T, Allocator>::rend() {
+    return reverse_iterator(begin());
+}
+
+template<typename T, typename Allocator>
+typename structures::DoublyLinkedList<T, Allocator>::const_reverse_iterator
+structures::DoublyLinkedList<T, Allocator>::rend() const {
+    return const_reverse_iterator(begin());
+}
+
+template<typename T, typename Allocator>
+structures::Node<T>* structures::DoublyLinkedList<T, Allocator>::node_at(
     std::size_t index
 ) {
-    if (index < 0 || index > size()-1)
+    if (index >= size())
         throw std::out_of_range("Invalid index");
 
-    // começa a busca pela cabeça da listaa
-    auto node = head;
+    structures::Node<T>* node;
 
-    // itera os elementos indo um a um utilizando next()
-    for (std::size_t i = 0; i < index; i++) {
-        node = node->next();
+    if (index < size() / 2) {
+        // índice na primeira metade: percorre a partir da cabeça
+        node = head;
+        for (std::size_t i = 0; i < index; i++)
+            node = node->next();
+    } else {
+        // índice na segunda metade: percorre a partir da cauda
+        node = tail;
+        for (std::size_t i = size() - 1; i > index; i--)
+            node = node->prev();
     }
 
     return node;
 }
+
+template<typename T, typename Allocator>
+structures::Node<T>* structures::DoublyLinkedList<T, Allocator>::link_before(
+    Node<T>* next,
+    const T& data
+) {
+    structures::Node<T>* prev = next == nullptr ? tail : next->prev();
+    structures::Node<T>* new_node = create_node(data, prev, next);
+
+    if (prev == nullptr)
+        head = new_node;
+    else
+        prev->next(new_node);
+
+    if (next == nullptr)
+        tail = new_node;
+    else
+        next->prev(new_node);
+
+    size_++;
+    return new_node;
+}
+
+template<typename T, typename Allocator>
+void structures::DoublyLinkedList<T, Allocator>::unlink(Node<T>* node) {
+    if (node->prev() == nullptr)
+        head = node->next();
+    else
+        node->prev()->next(node->next());
+
+    if (node->next() == nullptr)
+        tail = node->prev();
+    else
+        node->next()->prev(node->prev());
+
+    size_--;
+}
+
+template<typename T, typename Allocator>
+template<typename... Args>
+structures::Node<T>* structures::DoublyLinkedList<T, Allocator>::create_node(
+    Args&&... args
+) {
+    return new (allocator_.allocate()) Node<T>(std::forward<Args>(args)...);
+}
+
+template<typename T, typename Allocator>
+void structures::DoublyLinkedList<T, Allocator>::destroy_node(Node<T>* node) {
+    node->~Node<T>();
+    allocator_.deallocate(node);
+}
@@ -0,0 +1,174 @@
+//! Copyright [year] <Copyright Owner>
+#ifndef STRUCTURES_NODE_POOL_H
+#define STRUCTURES_NODE_POOL_H
+
+#include <cstdint>
+#include <new>
+
+namespace structures {
+
+//! Classe NodePool, alocador de Nodes para as listas encadeadas.
+//! Os Nodes são entregues a partir de blocos contíguos de CHUNK_SIZE
+//! posições e os Nodes devolvidos vão para uma lista de livres, sendo
+//! reaproveitados antes de se abrir um novo bloco. release() libera
+//! todos os Nodes de uma vez, em O(blocos)
+template<typename N, std::size_t CHUNK_SIZE = 64>
+class NodePool {
+ public:
+    //! Indica que release() devolve todos os Nodes alocados
+    static const bool releases_all = true;
+    //! Construtor padrão de NodePool
+    NodePool();
+    //! Destrutor padrão de NodePool, libera todos os blocos
+    ~NodePool();
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+    //! Retorna memória não inicializada para um Node
+    N* allocate();
+    //! Devolve à lista de livres a memória de um Node já destruído
+    void deallocate(N* node);
+    //! Libera todos os blocos do pool
+    void release();
+    //! Passa a ser dono dos blocos de [other], que fica vazio. As
+    //! posições livres de [other] entram na nossa lista de livres, e as
+    //! ainda não usadas do seu bloco mais recente também, se este pool
+    //! já tiver um bloco em uso; custa no máximo CHUNK_SIZE passos
+    void merge(NodePool& other);
+
+ private:
+    //! Posição de um bloco: guarda um Node ou o próximo livre
+    union Slot {
+        Slot* next;
+        alignas(N) unsigned char storage[sizeof(N)];
+    };
+
+    //! Bloco de posições contíguas
+    struct Chunk {
+        Chunk* next;
+        Slot slots[CHUNK_SIZE];
+    };
+
+    //! Bloco mais recente, de onde saem as posições ainda não usadas
+    Chunk* chunks_{nullptr};
+    //! Último bloco da lista, para que merge() seja O(1)
+    Chunk* last_chunk_{nullptr};
+    //! Lista de posições devolvidas
+    Slot* free_{nullptr};
+    //! Última posição de free_ (válida se free_ não for nulo), para que
+    //! merge() junte as listas de livres em O(1)
+    Slot* free_last_{nullptr};
+    //! Quantidade de posições já entregues do bloco mais recente
+    std::size_t used_{CHUNK_SIZE};
+};
+
+//! Classe NewAllocator, aloca cada Node individualmente com new/delete
+template<typename N>
+class NewAllocator {
+ public:
+    //! Indica que release() não libera os Nodes alocados
+    static const bool releases_all = false;
+    //! Retorna memória não inicializada para um Node
+    N* allocate() {
+        return static_cast<N*>(::operator new(sizeof(N)));
+    }
+    //! Libera a memória de um Node já destruído
+    void deallocate(N* node) {
+        ::operator delete(node);
+    }
+    //! Não há nada a liberar em bloco
+    void release() {}
+    //! Não há nada a adotar de [other]
+    void merge(NewAllocator&) {}
+};
+
+}  // namespace structures
+
+#endif
+
+// Implementações de NodePool
+
+template<typename N, std::size_t CHUNK_SIZE>
+structures::NodePool<N, CHUNK_SIZE>::NodePool() {}
+
+template<typename N, std::size_t CHUNK_SIZE>
+structures::NodePool<N, CHUNK_SIZE>::~NodePool() {
+    release();
+}
+
+template<typename N, std::size_t CHUNK_SIZE>
+N* structures::NodePool<N, CHUNK_SIZE>::allocate() {
+    // reaproveita uma posição devolvida, se houver
+    if (free_ != nullptr) {
+        Slot* slot = free_;
+        free_ = slot->next;
+        return reinterpret_cast<N*>(slot->storage);
+    }
+
+    // abre um novo bloco quando o atual está esgotado
+    if (used_ == CHUNK_SIZE) {
+        Chunk* chunk = static_cast<Chunk*>(::operator new(sizeof(Chunk)));
+        chunk->next = chunks_;
+        if (chunks_ == nullptr)
+            last_chunk_ = chunk;
+        chunks_ = chunk;
+        used_ = 0;
+    }
+
+    return reinterpret_cast<N*>(chunks_->slots[used_++].storage);
+}
+
+template<typename N, std::size_t CHUNK_SIZE>
+void structures::NodePool<N, CHUNK_SIZE>::deallocate(N* node) {
+    Slot* slot = reinterpret_cast<Slot*>(node);
+    slot->next = free_;
+    if (free_ == nullptr)
+        free_last_ = slot;
+    free_ = slot;
+}
+
+template<typename N, std::size_t CHUNK_SIZE>
+void structures::NodePool<N, CHUNK_SIZE>::release() {
+    while (chunks_ != nullptr) {
+        Chunk* next = chunks_->next;
+        ::operator delete(chunks_);
+        chunks_ = next;
+    }
+
+    last_chunk_ = nullptr;
+    free_ = nullptr;
+    free_last_ = nullptr;
+    used_ = CHUNK_SIZE;
+}
+
+template<typename N, std::size_t CHUNK_SIZE>
+void structures::NodePool<N, CHUNK_SIZE>::merge(NodePool& other) {
+    if (other.chunks_ == nullptr)
+        return;
+
+    // os blocos de [other] entram depois dos nossos, mantendo o bloco
+    // mais recente (e suas posições não usadas) no início da lista
+    if (chunks_ == nullptr) {
+        chunks_ = other.chunks_;
+        used_ = other.used_;
+    } else {
+        // só um bloco pode ter posições não usadas: as de [other] viram
+        // posições livres
+        for (std::size_t i = other.used_; i < CHUNK_SIZE; i++)
+            deallocate(reinterpret_cast<N*>(other.chunks_->slots[i].storage));
+        last_chunk_->next = other.chunks_;
+    }
+    last_chunk_ = other.last_chunk_;
+
+    if (other.free_ != nullptr) {
+        other.free_last_->next = free_;
+        if (free_ == nullptr)
+            free_last_ = other.free_last_;
+        free_ = other.free_;
+    }
+
+    other.chunks_ = nullptr;
+    other.last_chunk_ = nullptr;
+    other.free_ = nullptr;
+    other.free_last_ = nullptr;
+    other.used_ = CHUNK_SIZE;
+}
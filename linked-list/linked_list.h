@@ -4,6 +4,10 @@
 
 #include <cstdint>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "node_pool.h"
 
 namespace structures {
 
@@ -33,8 +37,11 @@ class Node {
 
 //! Classe LinkedList, implementa uma estrutura de dados
 //! com encadeamento simples, que permite ao programador
-//! manipular listas com quantidades não determinadas de elementos
-template<typename T>
+//! manipular listas com quantidades não determinadas de elementos.
+//! Os Nodes são obtidos de [Allocator]; o padrão é um NodePool, que
+//! reaproveita Nodes removidos e permite que clear() libere a lista
+//! inteira de uma vez
+template<typename T, typename Allocator = NodePool<Node<T>>>
 class LinkedList {
  public:
     //! Construtor padrão de LinkedList
@@ -43,7 +50,7 @@ class LinkedList {
     ~LinkedList();
     //! Limpa a lista completamente
     void clear();
-    //! Insere elemento no fim da lista
+    //! Insere elemento no fim da lista, em O(1)
     void push_back(const T& data);
     //! Insere elemento no início da lista
     void push_front(const T& data);
@@ -55,12 +62,16 @@ class LinkedList {
     T& at(std::size_t index);
     //! Retira o elemento na posição [index] da lista
     T pop(std::size_t index);
-    //! Retira o elemento do fim da lista
+    //! Retira o elemento do fim da lista. Por ser encadeamento simples,
+    //! ainda precisa percorrer a lista para achar o penúltimo elemento
     T pop_back();
     //! Retira o elemento do início da lista
     T pop_front();
     //! Remove um elemento que contenha os dados em [data]
     void remove(const T& data);
+    //! Move todos os elementos de [other] para o fim da lista, em O(1).
+    //! [other] fica vazia
+    void splice(LinkedList& other);
     //! Verifica se a lista está vazia
     bool empty() const;
     //! Verifica se a lista contém um elemento [data]
@@ -78,8 +89,17 @@ class LinkedList {
     Node<T>* node_at(std::size_t index);
     //! Ponteiro para Node que é a cabeça da lista
     structures::Node<T>* head{nullptr};
+    //! Ponteiro para Node que é a cauda da lista
+    structures::Node<T>* tail{nullptr};
     //! Tamanho atual da lista
     std::size_t size_{0u};
+    //! Alocador dos Nodes da lista
+    Allocator allocator_;
+    //! Constrói um Node com memória obtida de allocator_
+    template<typename... Args>
+    Node<T>* create_node(Args&&... args);
+    //! Destrói um Node e devolve sua memória a allocator_
+    void destroy_node(Node<T>* node);
 };
 
 }  // namespace structures
@@ -126,63 +146,86 @@ void structures::Node<T>::next(Node<T>* next) {
 
 // Implementações de LinkedList
 
-template<typename T>
-structures::LinkedList<T>::LinkedList() {}
+template<typename T, typename Allocator>
+structures::LinkedList<T, Allocator>::LinkedList() {}
 
-template<typename T>
-structures::LinkedList<T>::~LinkedList() {
+template<typename T, typename Allocator>
+structures::LinkedList<T, Allocator>::~LinkedList() {
     clear();
 }
 
-template<typename T>
-void structures::LinkedList<T>::clear() {
-    // inicializa o último elemento excluido como o head
-    auto last = head;
-
-    // pega o próximo elemento a ser excluido a partir de last->next()
-    // remove o elemento sendo excluido atualmente
-    // itera até acabarem os elementos
-    for (std::size_t i = 0; i < size(); i++) {
-        auto next = last->next();
-        delete last;
-        last = next;
+template<typename T, typename Allocator>
+void structures::LinkedList<T, Allocator>::clear() {
+    // quando o alocador libera tudo em bloco e os dados não precisam de
+    // destrutor, não é necessário percorrer a lista
+    if (!Allocator::releases_all || !std::is_trivially_destructible<T>::value) {
+        // inicializa o último elemento excluido como o head
+        auto last = head;
+
+        // pega o próximo elemento a ser excluido a partir de last->next()
+        // remove o elemento sendo excluido atualmente
+        // itera até acabarem os elementos
+        for (std::size_t i = 0; i < size(); i++) {
+            auto next = last->next();
+            destroy_node(last);
+            last = next;
+        }
     }
 
-    // seta o head como o ponteiro nulo e o tamanho como 0
+    allocator_.release();
+
+    // seta head e tail como o ponteiro nulo e o tamanho como 0
     head = nullptr;
+    tail = nullptr;
     size_ = 0;
 }
 
-template<typename T>
-void structures::LinkedList<T>::push_back(const T& data) {
-    insert(data, size());
+template<typename T, typename Allocator>
+void structures::LinkedList<T, Allocator>::push_back(const T& data) {
+    if (empty()) {
+        push_front(data);
+        return;
+    }
+
+    // encadeia o novo Node depois da cauda, sem percorrer a lista
+    auto new_node = create_node(data);
+    tail->next(new_node);
+    tail = new_node;
+    size_++;
 }
 
-template<typename T>
-void structures::LinkedList<T>::push_front(const T& data) {
-    structures::Node<T>* new_node = new structures::Node<T>(data, head);
+template<typename T, typename Allocator>
+void structures::LinkedList<T, Allocator>::push_front(const T& data) {
+    structures::Node<T>* new_node = create_node(data, head);
     head = new_node;
+    if (tail == nullptr)
+        tail = new_node;
     size_++;
 }
 
-template<typename T>
-void structures::LinkedList<T>::insert(const T& data, std::size_t index) {
+template<typename T, typename Allocator>
+void structures::LinkedList<T, Allocator>::insert(
+    const T& data,
+    std::size_t index
+) {
     if (index < 0 || index > size()) {
         throw std::out_of_range("Invalid index");
     }
 
     if (index == 0) {
         push_front(data);
+    } else if (index == size()) {
+        push_back(data);
     } else {
         auto before = node_at(index - 1);
-        auto new_node = new structures::Node<T>(data, before->next());
+        auto new_node = create_node(data, before->next());
         before->next(new_node);
         size_++;
     }
 }
 
-template<typename T>
-void structures::LinkedList<T>::insert_sorted(const T& data) {
+template<typename T, typename Allocator>
+void structures::LinkedList<T, Allocator>::insert_sorted(const T& data) {
     // Inicializa node como a primeira posição da lista (head)
     auto node = head;
 
@@ -199,8 +242,8 @@ void structures::LinkedList<T>::insert_sorted(const T& data) {
     push_back(data);
 }
 
-template<typename T>
-T structures::LinkedList<T>::pop(std::size_t index) {
+template<typename T, typename Allocator>
+T structures::LinkedList<T, Allocator>::pop(std::size_t index) {
     if (index < 0 || index >= size())
         throw std::out_of_range("Invalid index");
 
@@ -213,33 +256,39 @@ T structures::LinkedList<T>::pop(std::size_t index) {
         structures::Node<T>* before = node_at(index - 1);
         structures::Node<T>* removed_node = before->next();
         before->next(removed_node->next());
+        if (removed_node == tail)
+            tail = before;
         T data = removed_node->data();
         size_--;
-        delete removed_node;
+        destroy_node(removed_node);
         return data;
     }
 }
 
-template<typename T>
-T structures::LinkedList<T>::pop_back() {
+template<typename T, typename Allocator>
+T structures::LinkedList<T, Allocator>::pop_back() {
     return pop(size() -1 );
 }
 
-template<typename T>
-T structures::LinkedList<T>::pop_front() {
+template<typename T, typename Allocator>
+T structures::LinkedList<T, Allocator>::pop_front() {
     if (empty())
         throw std::out_of_range("List is empty");
 
     structures::Node<T>* removed_node = head;
     T data = removed_node->data();
     head = head->next();
+    if (head == nullptr)
+        tail = nullptr;
     size_--;
-    delete removed_node;
+    destroy_node(removed_node);
     return data;
 }
 
-template<typename T>
-std::size_t structures::LinkedList<T>::find(const T& data) const {
+template<typename T, typename Allocator>
+std::size_t structures::LinkedList<T, Allocator>::find(
+    const T& data
+) const {
     // começa a busca pelo primeiro elemento da lista
     auto node = head;
     // itera comparando o valor recebido de data com o data de cada elemento
@@ -255,41 +304,67 @@ std::size_t structures::LinkedList<T>::find(const T& data) const {
     return size();
 }
 
-template<typename T>
-void structures::LinkedList<T>::remove(const T& data) {
+template<typename T, typename Allocator>
+void structures::LinkedList<T, Allocator>::remove(const T& data) {
     pop(find(data));
 }
 
-template<typename T>
-bool structures::LinkedList<T>::empty() const {
+template<typename T, typename Allocator>
+void structures::LinkedList<T, Allocator>::splice(LinkedList& other) {
+    if (&other == this || other.empty())
+        return;
+
+    // os Nodes de [other] passam a pertencer ao alocador desta lista
+    allocator_.merge(other.allocator_);
+
+    if (empty())
+        head = other.head;
+    else
+        tail->next(other.head);
+    tail = other.tail;
+    size_ += other.size_;
+
+    other.head = nullptr;
+    other.tail = nullptr;
+    other.size_ = 0;
+}
+
+template<typename T, typename Allocator>
+bool structures::LinkedList<T, Allocator>::empty() const {
     return size() == 0;
 }
 
-template<typename T>
-bool structures::LinkedList<T>::contains(const T& data) const {
+template<typename T, typename Allocator>
+bool structures::LinkedList<T, Allocator>::contains(const T& data) const {
     return find(data) != size();
 }
 
-template<typename T>
-std::size_t structures::LinkedList<T>::size() const {
+template<typename T, typename Allocator>
+std::size_t structures::LinkedList<T, Allocator>::size() const {
     return size_;
 }
 
-template<typename T>
-T& structures::LinkedList<T>::at(std::size_t index) {
+template<typename T, typename Allocator>
+T& structures::LinkedList<T, Allocator>::at(std::size_t index) {
     return node_at(index)->data();
 }
 
-template<typename T>
-T& structures::LinkedList<T>::operator[](std::size_t index) {
+template<typename T, typename Allocator>
+T& structures::LinkedList<T, Allocator>::operator[](std::size_t index) {
     return at(index);
 }
 
-template<typename T>
-structures::Node<T>* structures::LinkedList<T>::node_at(std::size_t index) {
+template<typename T, typename Allocator>
+structures::Node<T>* structures::LinkedList<T, Allocator>::node_at(
+    std::size_t index
+) {
     if (index < 0 || index > size()-1)
         throw std::out_of_range("Invalid index");
 
+    // o último elemento é acessado diretamente pela cauda
+    if (index == size() - 1)
+        return tail;
+
     // começa a busca pela cabeça da listaa
     auto node = head;
 
@@ -300,3 +375,17 @@ structures::Node<T>* structures::LinkedList<T>::node_at(std::size_t index) {
 
     return node;
 }
+
+template<typename T, typename Allocator>
+template<typename... Args>
+structures::Node<T>* structures::LinkedList<T, Allocator>::create_node(
+    Args&&... args
+) {
+    return new (allocator_.allocate()) Node<T>(std::forward<Args>(args)...);
+}
+
+template<typename T, typename Allocator>
+void structures::LinkedList<T, Allocator>::destroy_node(Node<T>* node) {
+    node->~Node<T>();
+    allocator_.deallocate(node);
+}
@@ -0,0 +1,95 @@
+//! Copyright [year] <Copyright Owner>
+//! Compara UnrolledLinkedList com LinkedList e ArrayList em buscas
+//! sequenciais e inserções no meio da lista, de 10^3 a 10^7 elementos.
+//! Compilar com: g++ -std=c++17 -O2 bench.cpp -o bench
+//! Uso: ./bench [maior expoente]  (padrão 7)
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "../array-list/array_list.h"
+#include "../linked-list/linked_list.h"
+#include "unrolled_linked_list.h"
+
+namespace {
+
+//! Quantidade de inserções no meio medidas em cada tamanho
+const std::size_t INSERTS = 100;
+//! Elementos percorridos, no total, nas buscas de cada tamanho
+const std::size_t SCANNED = 50000000;
+
+//! Segundos gastos por "body()"
+template<typename Body>
+double measure(Body body) {
+    auto start = std::chrono::steady_clock::now();
+    body();
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+//! Resultado de uma estrutura em um tamanho: ns por elemento percorrido
+//! numa busca sem sucesso, e µs por inserção na metade da lista
+struct Result {
+    double scan_ns;
+    double insert_us;
+};
+
+template<typename List>
+Result bench(List& list, std::size_t size) {
+    for (std::size_t i = 0; i < size; i++)
+        list.push_back(static_cast<int>(i));
+
+    // -1 não está na lista: contains percorre todos os elementos
+    std::size_t scans = SCANNED / size > 0 ? SCANNED / size : 1;
+    std::size_t found = 0;
+    double scan = measure([&]() {
+        for (std::size_t s = 0; s < scans; s++)
+            found += list.contains(-1);
+    });
+
+    double insert = measure([&]() {
+        for (std::size_t i = 0; i < INSERTS; i++)
+            list.insert(static_cast<int>(i), list.size() / 2);
+    });
+
+    if (found != 0 || list.size() != size + INSERTS)
+        std::printf("erro: resultado inesperado\n");
+
+    return Result{scan / (scans * size) * 1e9, insert / INSERTS * 1e6};
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    int max_exponent = argc > 1 ? std::atoi(argv[1]) : 7;
+
+    std::printf("%10s | %32s | %32s\n", "",
+                "busca (ns/elemento)", "insercao no meio (us)");
+    std::printf("%10s | %10s %10s %10s | %10s %10s %10s\n", "elementos",
+                "unrolled", "linked", "array", "unrolled", "linked", "array");
+
+    std::size_t size = 1000;
+    for (int exponent = 3; exponent <= max_exponent; exponent++, size *= 10) {
+        Result unrolled, linked, array;
+        {
+            structures::UnrolledLinkedList<int> list;
+            unrolled = bench(list, size);
+        }
+        {
+            structures::LinkedList<int> list;
+            linked = bench(list, size);
+        }
+        {
+            structures::ArrayList<int> list(16, true);
+            array = bench(list, size);
+        }
+
+        std::printf("%10zu | %10.3f %10.3f %10.3f | %10.2f %10.2f %10.2f\n", size,
+                    unrolled.scan_ns, linked.scan_ns, array.scan_ns,
+                    unrolled.insert_us, linked.insert_us, array.insert_us);
+    }
+
+    return 0;
+}
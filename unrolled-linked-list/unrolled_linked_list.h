@@ -0,0 +1,371 @@
+//! Copyright [year] <Copyright Owner>
+#ifndef STRUCTURES_UNROLLED_LINKED_LIST_H
+#define STRUCTURES_UNROLLED_LINKED_LIST_H
+
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+namespace structures {
+
+//! Classe UnrolledLinkedList, lista encadeada em que cada Node guarda um
+//! bloco de até N elementos contíguos, o que reduz a quantidade de
+//! ponteiros seguidos (e de faltas de cache) ao percorrer a lista.
+//! Um bloco cheio é dividido em dois ao receber um novo elemento e um
+//! bloco com menos da metade da capacidade é juntado ao seguinte
+template<typename T, std::size_t N = 16>
+class UnrolledLinkedList {
+    static_assert(N >= 2, "UnrolledLinkedList precisa de blocos com N >= 2");
+
+ public:
+    //! Construtor padrão de UnrolledLinkedList
+    UnrolledLinkedList();
+    //! Destrutor padrão de UnrolledLinkedList
+    ~UnrolledLinkedList();
+    //! Limpa a lista completamente
+    void clear();
+    //! Insere elemento no fim da lista
+    void push_back(const T& data);
+    //! Insere elemento no início da lista
+    void push_front(const T& data);
+    //! Insere elemento na posição [index] da lista
+    void insert(const T& data, std::size_t index);
+    //! Insere elemento mantendo a ordenação da lista
+    void insert_sorted(const T& data);
+    //! Acessa o elemento na posição [index] da lista
+    T& at(std::size_t index);
+    //! Retira o elemento na posição [index] da lista
+    T pop(std::size_t index);
+    //! Retira o elemento do fim da lista
+    T pop_back();
+    //! Retira o elemento do início da lista
+    T pop_front();
+    //! Remove um elemento que contenha os dados em [data]
+    void remove(const T& data);
+    //! Verifica se a lista está vazia
+    bool empty() const;
+    //! Verifica se a lista contém um elemento [data]
+    bool contains(const T& data) const;
+    //! Encontra a posição de um elemento que contém [data]
+    std::size_t find(const T& data) const;
+    //! Retorna o tamanho da lista
+    std::size_t size() const;
+    //! Overload de operadores para que a lista
+    //! utilize []
+    T& operator[](std::size_t index);
+
+ private:
+    //! Bloco de até N elementos, encadeado ao próximo bloco
+    struct Block {
+        T data[N];
+        std::size_t count{0u};
+        Block* next{nullptr};
+    };
+
+    //! Encontra o bloco que contém o índice [index], devolvendo em
+    //! [offset] a posição dentro do bloco e em [prev] o bloco anterior
+    Block* block_at(std::size_t index, std::size_t& offset, Block*& prev);
+    //! Insere [data] na posição [offset] de [block], dividindo o bloco
+    //! se ele estiver cheio
+    void insert_at(Block* block, std::size_t offset, const T& data);
+    //! Retira o elemento na posição [offset] de [block], juntando o
+    //! bloco ao seguinte se ficar com menos da metade da capacidade
+    T pop_at(Block* block, std::size_t offset, Block* prev);
+    //! Cria um bloco vazio depois de [block] (nullptr cria na cabeça)
+    Block* new_block_after(Block* block);
+    //! Move para um novo bloco a metade superior de [block]
+    void split(Block* block);
+
+    //! Ponteiro para o primeiro bloco da lista
+    Block* head{nullptr};
+    //! Ponteiro para o último bloco da lista
+    Block* tail{nullptr};
+    //! Tamanho atual da lista
+    std::size_t size_{0u};
+};
+
+}  // namespace structures
+
+#endif
+
+// Implementações de UnrolledLinkedList
+
+template<typename T, std::size_t N>
+structures::UnrolledLinkedList<T, N>::UnrolledLinkedList() {}
+
+template<typename T, std::size_t N>
+structures::UnrolledLinkedList<T, N>::~UnrolledLinkedList() {
+    clear();
+}
+
+template<typename T, std::size_t N>
+void structures::UnrolledLinkedList<T, N>::clear() {
+    // remove bloco a bloco, e não elemento a elemento
+    while (head != nullptr) {
+        Block* next = head->next;
+        delete head;
+        head = next;
+    }
+
+    tail = nullptr;
+    size_ = 0;
+}
+
+template<typename T, std::size_t N>
+void structures::UnrolledLinkedList<T, N>::push_back(const T& data) {
+    // ao anexar no fim, um bloco cheio não é dividido: um novo bloco é
+    // aberto, para que preenchimentos sequenciais deixem blocos cheios
+    if (tail == nullptr || tail->count == N)
+        new_block_after(tail);
+
+    tail->data[tail->count++] = data;
+    size_++;
+}
+
+template<typename T, std::size_t N>
+void structures::UnrolledLinkedList<T, N>::push_front(const T& data) {
+    if (head == nullptr)
+        new_block_after(nullptr);
+
+    insert_at(head, 0, data);
+}
+
+template<typename T, std::size_t N>
+void structures::UnrolledLinkedList<T, N>::insert(
+    const T& data,
+    std::size_t index
+) {
+    if (index > size())
+        throw std::out_of_range("Invalid index");
+
+    if (index == size()) {
+        push_back(data);
+    } else {
+        std::size_t offset;
+        Block* prev;
+        Block* block = block_at(index, offset, prev);
+        insert_at(block, offset, data);
+    }
+}
+
+template<typename T, std::size_t N>
+void structures::UnrolledLinkedList<T, N>::insert_sorted(const T& data) {
+    // procura, bloco a bloco, o primeiro elemento maior ou igual a data
+    for (Block* block = head; block != nullptr; block = block->next) {
+        // pula o bloco inteiro se seu último elemento ainda é menor
+        if (data > block->data[block->count - 1])
+            continue;
+
+        std::size_t offset = 0;
+        while (data > block->data[offset])
+            offset++;
+
+        insert_at(block, offset, data);
+        return;
+    }
+
+    // Caso não encontre a ordenação até aqui, o elemento deve ser o último
+    push_back(data);
+}
+
+template<typename T, std::size_t N>
+T& structures::UnrolledLinkedList<T, N>::at(std::size_t index) {
+    if (index >= size())
+        throw std::out_of_range("Invalid index");
+
+    std::size_t offset;
+    Block* prev;
+    return block_at(index, offset, prev)->data[offset];
+}
+
+template<typename T, std::size_t N>
+T structures::UnrolledLinkedList<T, N>::pop(std::size_t index) {
+    if (index >= size())
+        throw std::out_of_range("Invalid index");
+
+    std::size_t offset;
+    Block* prev;
+    Block* block = block_at(index, offset, prev);
+    return pop_at(block, offset, prev);
+}
+
+template<typename T, std::size_t N>
+T structures::UnrolledLinkedList<T, N>::pop_back() {
+    if (empty())
+        throw std::out_of_range("List is empty");
+
+    return pop(size() - 1);
+}
+
+template<typename T, std::size_t N>
+T structures::UnrolledLinkedList<T, N>::pop_front() {
+    if (empty())
+        throw std::out_of_range("List is empty");
+
+    return pop_at(head, 0, nullptr);
+}
+
+template<typename T, std::size_t N>
+void structures::UnrolledLinkedList<T, N>::remove(const T& data) {
+    pop(find(data));
+}
+
+template<typename T, std::size_t N>
+bool structures::UnrolledLinkedList<T, N>::empty() const {
+    return size() == 0;
+}
+
+template<typename T, std::size_t N>
+bool structures::UnrolledLinkedList<T, N>::contains(const T& data) const {
+    return find(data) != size();
+}
+
+template<typename T, std::size_t N>
+std::size_t structures::UnrolledLinkedList<T, N>::find(const T& data) const {
+    // percorre os elementos contíguos de cada bloco antes de seguir o
+    // ponteiro para o próximo
+    std::size_t index = 0;
+    for (const Block* block = head; block != nullptr; block = block->next) {
+        for (std::size_t i = 0; i < block->count; i++) {
+            if (data == block->data[i])
+                return index + i;
+        }
+        index += block->count;
+    }
+
+    return size();
+}
+
+template<typename T, std::size_t N>
+std::size_t structures::UnrolledLinkedList<T, N>::size() const {
+    return size_;
+}
+
+template<typename T, std::size_t N>
+T& structures::UnrolledLinkedList<T, N>::operator[](std::size_t index) {
+    return at(index);
+}
+
+template<typename T, std::size_t N>
+typename structures::UnrolledLinkedList<T, N>::Block*
+structures::UnrolledLinkedList<T, N>::block_at(
+    std::size_t index,
+    std::size_t& offset,
+    Block*& prev
+) {
+    // pula blocos inteiros até chegar ao que contém o índice
+    prev = nullptr;
+    Block* block = head;
+    while (index >= block->count) {
+        index -= block->count;
+        prev = block;
+        block = block->next;
+    }
+
+    offset = index;
+    return block;
+}
+
+template<typename T, std::size_t N>
+void structures::UnrolledLinkedList<T, N>::insert_at(
+    Block* block,
+    std::size_t offset,
+    const T& data
+) {
+    if (block->count == N) {
+        split(block);
+        // a posição pode ter passado para o novo bloco
+        if (offset > block->count) {
+            offset -= block->count;
+            block = block->next;
+        }
+    }
+
+    for (std::size_t i = block->count; i > offset; i--)
+        block->data[i] = std::move(block->data[i - 1]);
+
+    block->data[offset] = data;
+    block->count++;
+    size_++;
+}
+
+template<typename T, std::size_t N>
+T structures::UnrolledLinkedList<T, N>::pop_at(
+    Block* block,
+    std::size_t offset,
+    Block* prev
+) {
+    T data = std::move(block->data[offset]);
+
+    for (std::size_t i = offset + 1; i < block->count; i++)
+        block->data[i - 1] = std::move(block->data[i]);
+
+    block->count--;
+    size_--;
+
+    Block* next = block->next;
+
+    if (block->count == 0) {
+        // bloco vazio: remove-o da lista
+        if (prev == nullptr)
+            head = next;
+        else
+            prev->next = next;
+        if (tail == block)
+            tail = prev;
+        delete block;
+    } else if (block->count < N / 2 && next != nullptr) {
+        if (block->count + next->count <= N) {
+            // cabe tudo em um bloco: traz os elementos do próximo e o remove
+            for (std::size_t i = 0; i < next->count; i++)
+                block->data[block->count + i] = std::move(next->data[i]);
+            block->count += next->count;
+            block->next = next->next;
+            if (tail == next)
+                tail = block;
+            delete next;
+        } else {
+            // do contrário, empresta elementos do próximo até a metade
+            std::size_t moved = N / 2 - block->count;
+            for (std::size_t i = 0; i < moved; i++)
+                block->data[block->count + i] = std::move(next->data[i]);
+            for (std::size_t i = moved; i < next->count; i++)
+                next->data[i - moved] = std::move(next->data[i]);
+            block->count += moved;
+            next->count -= moved;
+        }
+    }
+
+    return data;
+}
+
+template<typename T, std::size_t N>
+typename structures::UnrolledLinkedList<T, N>::Block*
+structures::UnrolledLinkedList<T, N>::new_block_after(Block* block) {
+    Block* new_block = new Block;
+
+    if (block == nullptr) {
+        new_block->next = head;
+        head = new_block;
+    } else {
+        new_block->next = block->next;
+        block->next = new_block;
+    }
+
+    if (tail == block)
+        tail = new_block;
+
+    return new_block;
+}
+
+template<typename T, std::size_t N>
+void structures::UnrolledLinkedList<T, N>::split(Block* block) {
+    Block* new_block = new_block_after(block);
+    std::size_t half = block->count / 2;
+
+    for (std::size_t i = half; i < block->count; i++)
+        new_block->data[i - half] = std::move(block->data[i]);
+
+    new_block->count = block->count - half;
+    block->count = half;
+}
@@ -0,0 +1,120 @@
+#ifndef STRUCTURES_ARRAY_STACK_H
+#define STRUCTURES_ARRAY_STACK_H
+
+#include <cstdint>
+#include <stdexcept>
+
+namespace structures {
+
+//! ArrayStack implementation
+/*!
+    Pilha em um vetor contíguo, que dobra de tamanho quando enche. Depois que
+    o vetor atinge o tamanho máximo usado, push e pop não alocam memória.
+*/
+template<typename T>
+class ArrayStack {
+ public:
+    ArrayStack();
+    explicit ArrayStack(std::size_t max);
+    ~ArrayStack();
+
+    ArrayStack(const ArrayStack&) = delete;
+    ArrayStack& operator=(const ArrayStack&) = delete;
+
+    //! Empilha um elemento
+    void push(const T& data);
+    //! Desempilha e retorna o topo
+    T pop();
+    //! Retorna o topo
+    T& top();
+    //! Limpa pilha, mantendo o vetor
+    void clear();
+    //! Retorna o tamanho atual
+    std::size_t size() const;
+    //! Retorna a capacidade atual
+    std::size_t max_size() const;
+    //! Verifica se está vazia
+    bool empty() const;
+
+ private:
+    T* contents;
+    std::size_t size_;
+    std::size_t max_size_;
+
+    static const auto DEFAULT_SIZE = 16u;
+};
+
+template<typename T>
+ArrayStack<T>::ArrayStack():
+    ArrayStack(DEFAULT_SIZE)
+{}
+
+template<typename T>
+ArrayStack<T>::ArrayStack(std::size_t max):
+    contents{new T[max > 0 ? max : 1]},
+    size_{0},
+    max_size_{max > 0 ? max : 1}
+{}
+
+template<typename T>
+ArrayStack<T>::~ArrayStack() {
+    delete[] contents;
+}
+
+template<typename T>
+void ArrayStack<T>::push(const T& data) {
+    if (size_ == max_size_) {
+        T* grown = new T[max_size_ * 2];
+
+        for (std::size_t i = 0; i < size_; i++)
+            grown[i] = contents[i];
+
+        delete[] contents;
+        contents = grown;
+        max_size_ *= 2;
+    }
+
+    contents[size_++] = data;
+}
+
+template<typename T>
+T ArrayStack<T>::pop() {
+    if (empty()) {
+        throw std::out_of_range("Stack is empty");
+    }
+
+    return contents[--size_];
+}
+
+template<typename T>
+T& ArrayStack<T>::top() {
+    if (empty()) {
+        throw std::out_of_range("Stack is empty");
+    }
+
+    return contents[size_ - 1];
+}
+
+template<typename T>
+void ArrayStack<T>::clear() {
+    size_ = 0;
+}
+
+template<typename T>
+std::size_t ArrayStack<T>::size() const {
+    return size_;
+}
+
+template<typename T>
+std::size_t ArrayStack<T>::max_size() const {
+    return max_size_;
+}
+
+template<typename T>
+bool ArrayStack<T>::empty() const {
+    return size_ == 0;
+}
+
+}  // namespace structures
+
+#endif
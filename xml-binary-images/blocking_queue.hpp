@@ -0,0 +1,92 @@
+#ifndef STRUCTURES_BLOCKING_QUEUE_H
+#define STRUCTURES_BLOCKING_QUEUE_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace structures {
+
+//! BlockingQueue implementation
+/*!
+    Fila circular de capacidade fixa para várias threads. push espera
+    enquanto a fila está cheia e pop espera enquanto está vazia, sem consumir
+    processador. Depois de close, pop esvazia a fila e então retorna false.
+*/
+template<typename T>
+class BlockingQueue {
+ public:
+    explicit BlockingQueue(std::size_t max);
+
+    BlockingQueue(const BlockingQueue&) = delete;
+    BlockingQueue& operator=(const BlockingQueue&) = delete;
+
+    //! Enfileira, esperando por espaço
+    void push(T data);
+    //! Desenfileira em "data", esperando por um elemento. Retorna false se
+    //! a fila foi fechada e está vazia
+    bool pop(T& data);
+    //! Indica que não haverá mais push
+    void close();
+
+ private:
+    std::vector<T> contents;
+    std::size_t begin_{0u};
+    std::size_t size_{0u};
+    bool closed_{false};
+
+    std::mutex mutex_;
+    std::condition_variable not_full_;
+    std::condition_variable not_empty_;
+};
+
+template<typename T>
+BlockingQueue<T>::BlockingQueue(std::size_t max):
+    contents(max > 0 ? max : 1)
+{}
+
+template<typename T>
+void BlockingQueue<T>::push(T data) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_full_.wait(lock, [this]() { return size_ < contents.size(); });
+
+    contents[(begin_ + size_) % contents.size()] = std::move(data);
+    size_++;
+
+    lock.unlock();
+    not_empty_.notify_one();
+}
+
+template<typename T>
+bool BlockingQueue<T>::pop(T& data) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_empty_.wait(lock, [this]() { return size_ > 0 || closed_; });
+
+    if (size_ == 0)
+        return false;
+
+    data = std::move(contents[begin_]);
+    begin_ = (begin_ + 1) % contents.size();
+    size_--;
+
+    lock.unlock();
+    not_full_.notify_one();
+
+    return true;
+}
+
+template<typename T>
+void BlockingQueue<T>::close() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+    }
+
+    not_empty_.notify_all();
+}
+
+}  // namespace structures
+
+#endif
@@ -0,0 +1,140 @@
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "blocking_queue.hpp"
+#include "pipeline.hpp"
+#include "region_counter.hpp"
+#include "xml_reader.hpp"
+
+namespace pipeline {
+
+// A partir de quantos pixels uma imagem é dividida em faixas
+static const long long PARALLEL_PIXELS = 1 << 20;
+
+// Imagem a ser contada e sua posição no arquivo
+struct Job {
+    std::size_t index;
+    xml::Image image;
+};
+
+// Linha de saída de uma imagem, imagem inválida, ou a exceção lançada ao
+// processá-la (por exemplo, uma dimensão que não é um número)
+struct Result {
+    bool invalid;
+    std::string line;
+    std::exception_ptr error;
+};
+
+// Conta as regiões de uma imagem. Imagens grandes são divididas em faixas
+// quando há mais de um núcleo livre. Exceções não saem da thread do worker:
+// voltam no resultado.
+static Result count(const xml::Image& image, unsigned threads) {
+    try {
+        const int width = std::stoi(image.width);
+        const int height = std::stoi(image.height);
+
+        // Imagem inválida: com alguma das dimensões menores ou iguais a 0
+        if (height <= 0 || width <= 0) return Result{true, std::string(), nullptr};
+
+        // Conta direto das sequências de '1' do texto, sem montar a imagem
+        int regions = static_cast<long long>(width) * height >= PARALLEL_PIXELS && threads > 1
+                    ? region_counter::parallel_counter(image.data, width, height, threads)
+                    : region_counter::run_length_counter(image.data, width, height);
+
+        return Result{false, image.name + ' ' + std::to_string(regions) + '\n', nullptr};
+    } catch (...) {
+        return Result{false, std::string(), std::current_exception()};
+    }
+}
+
+// Buffer de reordenação: guarda os resultados que chegaram antes dos
+// anteriores e passa para a saída todos os que já estão em sequência. Depois
+// da primeira imagem inválida ou com erro, os resultados seguintes são
+// descartados; um erro só é guardado se a sua imagem for de fato alcançada.
+class ReorderBuffer {
+ public:
+    explicit ReorderBuffer(Report& report):
+        report_{report}
+    {}
+
+    void add(std::size_t index, Result result) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_.emplace(index, std::move(result));
+
+        for (auto it = pending_.find(next_); it != pending_.end(); it = pending_.find(next_)) {
+            if (!stopped()) {
+                if (it->second.error)
+                    report_.error = it->second.error;
+                else if (it->second.invalid)
+                    report_.invalid_image = true;
+                else
+                    report_.output += it->second.line;
+            }
+
+            pending_.erase(it);
+            next_++;
+        }
+    }
+
+ private:
+    bool stopped() const {
+        return report_.invalid_image || report_.error;
+    }
+
+    Report& report_;
+    std::mutex mutex_;
+    std::map<std::size_t, Result> pending_;
+    std::size_t next_{0u};
+};
+
+Report process(std::istream& input, unsigned workers, unsigned cores) {
+    Report report{true, false, std::string(), nullptr};
+    workers = std::max(1u, workers);
+    cores = std::max(1u, cores);
+
+    structures::BlockingQueue<Job> jobs(2 * workers);
+    ReorderBuffer results(report);
+
+    // Workers contando uma imagem; os demais estão parados na fila e seus
+    // núcleos ficam para as faixas de uma imagem grande
+    std::atomic<unsigned> busy{0u};
+
+    std::vector<std::thread> pool;
+    for (unsigned w = 0; w < workers; w++) {
+        pool.emplace_back([&]() {
+            Job job;
+            while (jobs.pop(job)) {
+                // Este worker e os núcleos livres no momento
+                unsigned active = ++busy;
+                unsigned threads = active < cores ? cores - active + 1 : 1u;
+                results.add(job.index, count(job.image, threads));
+                busy--;
+            }
+        });
+    }
+
+    // O arquivo é lido uma única vez, em blocos, enquanto os workers contam
+    xml::ImageReader reader(input);
+    Job job{0, xml::Image()};
+    while (reader.next(job.image)) {
+        std::size_t index = job.index;
+        jobs.push(std::move(job));
+        job = Job{index + 1, xml::Image()};
+    }
+
+    jobs.close();
+    for (std::thread& worker : pool)
+        worker.join();
+
+    report.valid = reader.valid();
+
+    return report;
+}
+
+}  // namespace pipeline
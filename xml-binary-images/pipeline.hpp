@@ -0,0 +1,42 @@
+#ifndef XML_PIPELINE_HPP
+#define XML_PIPELINE_HPP
+
+#include <exception>
+#include <istream>
+#include <string>
+#include <thread>
+
+namespace pipeline {
+
+    /**
+     * @brief Resultado do processamento de um arquivo XML.
+    */
+    struct Report {
+        /// Aninhamento das tags correto no arquivo inteiro
+        bool valid;
+        /// Alguma imagem tem dimensão menor ou igual a 0
+        bool invalid_image;
+        /// Uma linha "nome regiões" por imagem, na ordem do arquivo, até a
+        /// primeira imagem inválida
+        std::string output;
+        /// Exceção da primeira imagem alcançada que não pôde ser processada
+        std::exception_ptr error;
+    };
+
+    /**
+     * @brief Lê o arquivo na thread atual e conta as regiões das imagens em
+     * "workers" threads. O leitor coloca as imagens em uma fila limitada, de
+     * onde os workers as retiram; os resultados voltam à ordem do arquivo
+     * por um buffer de reordenação indexado pela posição de cada imagem.
+     * Uma exceção ao processar uma imagem alcançada não é relançada: fica em
+     * "error", para ser tratada só depois de verificar "valid".
+     * Uma imagem grande é dividida em faixas usando os "cores" núcleos que
+     * não estão com outros workers no momento em que ela começa a ser
+     * contada: sozinha, usa todos; com os workers ocupados, só o próprio.
+    */
+    Report process(std::istream& input, unsigned workers,
+                   unsigned cores = std::thread::hardware_concurrency());
+
+}  // namespace pipeline
+
+#endif
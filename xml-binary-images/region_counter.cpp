@@ -1,3 +1,10 @@
+#include <cstring>
+#include <thread>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
 #include "region_counter.hpp"
 
 namespace region_counter {
@@ -79,4 +86,528 @@ std::vector<std::vector<bool>> create_matrix(const std::string& str_matrix, int
     return matrix;
 }
 
-}
\ No newline at end of file
+BitImage::BitImage(int width, int height):
+    width{width},
+    height{height},
+    stride{(static_cast<std::size_t>(width) + 63) / 64},
+    words(stride * height, 0)
+{}
+
+// Deslocamentos (linha, coluna) dos vizinhos de cada vizinhança, conhecidos
+// em tempo de compilação: não há teste de vizinhança em tempo de execução.
+
+template<int CONNECTIVITY>
+struct Neighborhood;
+
+template<>
+struct Neighborhood<4> {
+    static constexpr int size = 4;
+    static constexpr int di[4] = {0, 0, -1, 1};
+    static constexpr int dj[4] = {-1, 1, 0, 0};
+};
+
+template<>
+struct Neighborhood<8> {
+    static constexpr int size = 8;
+    static constexpr int di[8] = {0, 0, -1, 1, -1, -1, 1, 1};
+    static constexpr int dj[8] = {-1, 1, 0, 0, -1, 1, -1, 1};
+};
+
+// Empilha o vizinho K de (i, j), se existir e for branco, e segue para o
+// vizinho K + 1. Como K é constante, cada vizinho é gerado como código
+// próprio e só os limites na direção do seu deslocamento são testados.
+
+template<int CONNECTIVITY, int K = 0>
+static void push_neighbors(BitImage& image, structures::ArrayStack<std::tuple<int, int>>& stack,
+                           int i, int j) {
+    using N = Neighborhood<CONNECTIVITY>;
+
+    if constexpr (K < N::size) {
+        constexpr int di = N::di[K];
+        constexpr int dj = N::dj[K];
+
+        if ((di >= 0 || i > 0) && (di <= 0 || i < image.height - 1)
+            && (dj >= 0 || j > 0) && (dj <= 0 || j < image.width - 1)
+            && image.get(i + di, j + dj)) {
+            image.reset(i + di, j + dj);
+            stack.push(std::make_tuple(i + di, j + dj));
+        }
+
+        push_neighbors<CONNECTIVITY, K + 1>(image, stack, i, j);
+    }
+}
+
+// Mesmo flood fill da versão com vector<vector<bool>>, mas o pixel é apagado
+// ao ser empilhado, e não ao ser desempilhado, então cada pixel entra na
+// pilha uma única vez. A pilha em vetor não aloca memória a cada pixel.
+
+template<int CONNECTIVITY>
+void clear_region(BitImage& image, int i, int j) {
+    structures::ArrayStack<std::tuple<int, int>> stack;
+
+    image.reset(i, j);
+    stack.push(std::make_tuple(i, j));
+
+    while (!stack.empty()) {
+        std::tuple<int, int> last = stack.pop();
+
+        push_neighbors<CONNECTIVITY>(image, stack, std::get<0>(last), std::get<1>(last));
+    }
+}
+
+// Percorre a imagem uma palavra de 64 pixels por vez: palavras zeradas são
+// puladas e, nas demais, o próximo pixel branco é o bit menos significativo.
+// A palavra é relida depois de cada clear_region, que pode tê-la alterado.
+
+template<int CONNECTIVITY>
+int connectivity_counter(BitImage image) {
+    int connectivity_count = 0;
+
+    for (int i = 0; i < image.height; i++) {
+        for (std::size_t w = 0; w < image.stride; w++) {
+            std::uint64_t word;
+
+            while ((word = image.words[i * image.stride + w]) != 0) {
+                connectivity_count++;
+                clear_region<CONNECTIVITY>(image, i, static_cast<int>(w * 64 + __builtin_ctzll(word)));
+            }
+        }
+    }
+
+    return connectivity_count;
+}
+
+template void clear_region<4>(BitImage& image, int i, int j);
+template void clear_region<8>(BitImage& image, int i, int j);
+template int connectivity_counter<4>(BitImage image);
+template int connectivity_counter<8>(BitImage image);
+
+// Raiz do conjunto de "label" no union-find, com compressão de caminho por
+// divisão: cada rótulo visitado passa a apontar para o avô.
+
+static int find_root(std::vector<int>& parent, int label) {
+    while (parent[label] != label) {
+        parent[label] = parent[parent[label]];
+        label = parent[label];
+    }
+
+    return label;
+}
+
+// Primeira passada: cada pixel branco recebe o rótulo do vizinho de cima ou
+// da esquerda, ou um rótulo provisório novo. Quando os dois vizinhos têm
+// rótulos diferentes, os conjuntos são unidos, com o menor rótulo como raiz;
+// assim a raiz de cada região é o rótulo do seu primeiro pixel na varredura.
+// Com vizinhança 8, as diagonais de cima só importam se o pixel de cima for
+// preto: senão já estão na região dele. A diagonal esquerda substitui a
+// esquerda quando esta é preta, e a direita ocupa o lugar do pixel de cima,
+// então continuam bastando dois vizinhos.
+// Segunda passada (só se "labels" for pedido): troca cada rótulo provisório
+// pelo número da sua região. Sem "labels", bastam as duas últimas linhas.
+
+template<int CONNECTIVITY>
+int label_regions(const BitImage& image, std::vector<int>* labels) {
+    const std::size_t width = image.width;
+    std::vector<int> rows;
+    std::vector<int>& provisional = labels ? *labels : rows;
+
+    provisional.assign(labels ? width * image.height : 2 * width, 0);
+
+    // parent[0] é o fundo
+    std::vector<int> parent(1, 0);
+
+    for (int i = 0; i < image.height; i++) {
+        int* current = provisional.data() + (labels ? i * width : (i & 1) * width);
+        const int* above = i == 0 ? nullptr
+                         : provisional.data() + (labels ? (i - 1) * width : ((i - 1) & 1) * width);
+
+        for (std::size_t w = 0; w < image.stride; w++) {
+            std::uint64_t word = image.words[i * image.stride + w];
+            int first = static_cast<int>(w * 64);
+            int last = std::min(first + 64, image.width);
+
+            // 64 pixels pretos de uma vez
+            if (word == 0) {
+                std::fill(current + first, current + last, 0);
+                continue;
+            }
+
+            for (int j = first; j < last; j++, word >>= 1) {
+                if (!(word & 1)) {
+                    current[j] = 0;
+                    continue;
+                }
+
+                int up = above ? above[j] : 0;
+                int left = j > 0 ? current[j - 1] : 0;
+
+                if (CONNECTIVITY == 8 && above && up == 0) {
+                    if (left == 0 && j > 0) left = above[j - 1];
+                    if (j + 1 < image.width) up = above[j + 1];
+                }
+
+                if (up == 0 && left == 0) {
+                    current[j] = static_cast<int>(parent.size());
+                    parent.push_back(current[j]);
+                } else if (up == 0 || left == 0 || up == left) {
+                    current[j] = up ? up : left;
+                } else {
+                    int a = find_root(parent, up);
+                    int b = find_root(parent, left);
+                    parent[std::max(a, b)] = std::min(a, b);
+                    current[j] = std::min(a, b);
+                }
+            }
+        }
+    }
+
+    // Raízes em ordem crescente recebem 1, 2, ...; como o pai de um rótulo
+    // é sempre menor que ele, o número da raiz já está definido
+    std::vector<int> region(parent.size(), 0);
+    int regions = 0;
+
+    for (int label = 1; label < static_cast<int>(parent.size()); label++) {
+        int root = find_root(parent, label);
+        region[label] = root == label ? ++regions : region[root];
+    }
+
+    if (labels)
+        for (int& label : *labels)
+            label = region[label];
+
+    return regions;
+}
+
+template int label_regions<4>(const BitImage& image, std::vector<int>* labels);
+template int label_regions<8>(const BitImage& image, std::vector<int>* labels);
+
+// Sequência de pixels brancos [start, end) de uma linha, com seu rótulo
+// no union-find.
+
+struct Run {
+    int start;
+    int end;
+    int label;
+};
+
+// Separa a linha "row" (de "width" caracteres, já limitada ao fim da string)
+// em sequências de '1'. O início de cada sequência é encontrado com memchr,
+// que pula os trechos pretos vários bytes por vez.
+
+static void find_runs(const char* row, int width, std::vector<int>& parent, std::vector<Run>& runs) {
+    runs.clear();
+
+    int j = 0;
+    while (j < width) {
+        const char* one = static_cast<const char*>(std::memchr(row + j, '1', width - j));
+        if (one == nullptr) break;
+
+        int start = static_cast<int>(one - row);
+        int end = start;
+        while (end < width && row[end] == '1') end++;
+
+        runs.push_back(Run{start, end, static_cast<int>(parent.size())});
+        parent.push_back(runs.back().label);
+        j = end;
+    }
+}
+
+// Estatísticas parciais de uma região: somas das linhas e colunas dos
+// pixels, para o centroide no final, e o retângulo envolvente.
+
+struct Accumulator {
+    long long area;
+    long long row_sum;
+    long long col_sum;
+    int top;
+    int left;
+    int bottom;
+    int right;
+};
+
+// Acumula "from" em "into", quando duas regiões são unidas.
+
+static void merge(Accumulator& into, const Accumulator& from) {
+    into.area += from.area;
+    into.row_sum += from.row_sum;
+    into.col_sum += from.col_sum;
+    into.top = std::min(into.top, from.top);
+    into.left = std::min(into.left, from.left);
+    into.bottom = std::max(into.bottom, from.bottom);
+    into.right = std::max(into.right, from.right);
+}
+
+// Resultado da rotulação de uma faixa de linhas: a quantidade de regiões
+// dentro da faixa e as sequências da primeira e da última linha, com o
+// rótulo já trocado pela raiz, para a junção com as faixas vizinhas.
+// "stats" tem um acumulador por rótulo local, se as estatísticas forem
+// pedidas; o da raiz tem os totais da região.
+
+struct Strip {
+    int regions;
+    std::vector<Run> first;
+    std::vector<Run> last;
+    std::vector<Accumulator> stats;
+};
+
+// Une os conjuntos de "x" e "y" com o menor rótulo como raiz, somando as
+// estatísticas na raiz. Retorna false se já estavam unidos.
+
+static bool unite(std::vector<int>& parent, std::vector<Accumulator>* stats, int x, int y) {
+    x = find_root(parent, x);
+    y = find_root(parent, y);
+
+    if (x == y) return false;
+
+    if (x > y) std::swap(x, y);
+    parent[y] = x;
+    if (stats) merge((*stats)[x], (*stats)[y]);
+
+    return true;
+}
+
+// Une as sequências de "upper" e "lower", linhas vizinhas, que se tocam: na
+// vizinhança-4, precisam de alguma coluna em comum; na vizinhança-8, basta
+// tocarem na diagonal, então cada sequência é estendida em uma coluna. As
+// sobreposições são encontradas percorrendo as duas listas em ordem.
+// Retorna quantas uniões juntaram regiões diferentes.
+
+template<int CONNECTIVITY>
+static int join_rows(const std::vector<Run>& upper, const std::vector<Run>& lower,
+                     std::vector<int>& parent, std::vector<Accumulator>* stats,
+                     int upper_offset, int lower_offset) {
+    static_assert(CONNECTIVITY == 4 || CONNECTIVITY == 8, "Connectivity must be 4 or 8");
+    constexpr int reach = CONNECTIVITY == 8 ? 1 : 0;
+
+    int joined = 0;
+    std::size_t a = 0;
+    std::size_t b = 0;
+
+    while (a < upper.size() && b < lower.size()) {
+        if (upper[a].start < lower[b].end + reach && lower[b].start < upper[a].end + reach) {
+            if (unite(parent, stats, upper[a].label + upper_offset, lower[b].label + lower_offset))
+                joined++;
+        }
+
+        // avança a sequência que termina primeiro
+        if (upper[a].end < lower[b].end)
+            a++;
+        else
+            b++;
+    }
+
+    return joined;
+}
+
+// Rotula as linhas [begin, end). Cada sequência começa como uma região, e
+// cada união bem-sucedida entre linhas vizinhas diminui a contagem em um.
+// "parent" recebe os rótulos locais da faixa, a partir de 0. Com
+// "collect", cada sequência nova também ganha seu acumulador.
+
+template<int CONNECTIVITY>
+static void label_strip(const std::string& str_matrix, int width, int begin, int end,
+                        bool collect, std::vector<int>& parent, Strip& strip) {
+    std::vector<Run> previous;
+    std::vector<Run> current;
+    std::vector<Accumulator>* stats = collect ? &strip.stats : nullptr;
+    strip.regions = 0;
+
+    for (int i = begin; i < end; i++) {
+        std::size_t row = static_cast<std::size_t>(i) * width;
+
+        // linhas além do fim da string são pretas
+        if (row < str_matrix.size()) {
+            int length = static_cast<int>(std::min<std::size_t>(width, str_matrix.size() - row));
+            find_runs(str_matrix.data() + row, length, parent, current);
+        } else {
+            current.clear();
+        }
+
+        if (stats) {
+            for (const Run& run : current) {
+                long long length = run.end - run.start;
+                stats->push_back(Accumulator{
+                    length,
+                    length * i,
+                    length * (run.start + run.end - 1) / 2,
+                    i, run.start, i, run.end - 1
+                });
+            }
+        }
+
+        strip.regions += static_cast<int>(current.size());
+        strip.regions -= join_rows<CONNECTIVITY>(previous, current, parent, stats, 0, 0);
+
+        if (i == begin)
+            strip.first = current;
+
+        std::swap(previous, current);
+    }
+
+    strip.last = previous;
+
+    for (Run& run : strip.first)
+        run.label = find_root(parent, run.label);
+    for (Run& run : strip.last)
+        run.label = find_root(parent, run.label);
+}
+
+// Converte os acumuladores das raízes em ComponentStats. As raízes em ordem
+// crescente de rótulo são as regiões na ordem da varredura, a mesma da
+// numeração da matriz R.
+
+static void collect_stats(std::vector<int>& parent, const std::vector<Accumulator>& stats,
+                          std::vector<ComponentStats>& out) {
+    out.clear();
+
+    for (int label = 0; label < static_cast<int>(parent.size()); label++) {
+        if (find_root(parent, label) != label) continue;
+
+        const Accumulator& region = stats[label];
+        out.push_back(ComponentStats{
+            region.area,
+            region.top, region.left, region.bottom, region.right,
+            static_cast<double>(region.row_sum) / region.area,
+            static_cast<double>(region.col_sum) / region.area
+        });
+    }
+}
+
+template<int CONNECTIVITY>
+int run_length_counter(const std::string& str_matrix, int width, int height,
+                       std::vector<ComponentStats>* stats) {
+    std::vector<int> parent;
+    Strip strip;
+
+    label_strip<CONNECTIVITY>(str_matrix, width, 0, height, stats != nullptr, parent, strip);
+
+    if (stats)
+        collect_stats(parent, strip.stats, *stats);
+
+    return strip.regions;
+}
+
+// Cada thread rotula uma faixa com seu próprio union-find, sem dividir
+// memória com as outras. Depois, os rótulos de cada faixa são deslocados
+// para um union-find global e a última linha de cada faixa é unida à
+// primeira da faixa seguinte; cada união diminui a contagem total em um.
+
+template<int CONNECTIVITY>
+int parallel_counter(const std::string& str_matrix, int width, int height, unsigned threads,
+                     std::vector<ComponentStats>* stats) {
+    unsigned count = std::max(1u, std::min<unsigned>(threads, std::max(height, 1)));
+
+    std::vector<std::vector<int>> parents(count);
+    std::vector<Strip> strips(count);
+    std::vector<std::thread> workers;
+
+    for (unsigned s = 0; s < count; s++) {
+        int begin = static_cast<int>(static_cast<long long>(height) * s / count);
+        int end = static_cast<int>(static_cast<long long>(height) * (s + 1) / count);
+
+        workers.emplace_back([&, s, begin, end]() {
+            label_strip<CONNECTIVITY>(str_matrix, width, begin, end, stats != nullptr,
+                                      parents[s], strips[s]);
+        });
+    }
+
+    for (std::thread& worker : workers)
+        worker.join();
+
+    // o rótulo local l da faixa s é o rótulo global offsets[s] + l
+    std::vector<int> offsets(count, 0);
+    for (unsigned s = 1; s < count; s++)
+        offsets[s] = offsets[s - 1] + static_cast<int>(parents[s - 1].size());
+
+    std::vector<int> parent(offsets[count - 1] + parents[count - 1].size());
+    for (std::size_t label = 0; label < parent.size(); label++)
+        parent[label] = static_cast<int>(label);
+
+    // cada raiz local entra no global com os totais da sua região
+    std::vector<Accumulator> global;
+    if (stats) {
+        for (unsigned s = 0; s < count; s++) {
+            for (int label = 0; label < static_cast<int>(parents[s].size()); label++) {
+                if (find_root(parents[s], label) != label)
+                    parent[offsets[s] + label] = offsets[s] + find_root(parents[s], label);
+                global.push_back(strips[s].stats[label]);
+            }
+        }
+    }
+
+    int regions = 0;
+    for (unsigned s = 0; s < count; s++)
+        regions += strips[s].regions;
+
+    for (unsigned s = 0; s + 1 < count; s++)
+        regions -= join_rows<CONNECTIVITY>(strips[s].last, strips[s + 1].first, parent,
+                                           stats ? &global : nullptr, offsets[s], offsets[s + 1]);
+
+    if (stats)
+        collect_stats(parent, global, *stats);
+
+    return regions;
+}
+
+template int run_length_counter<4>(const std::string& str_matrix, int width, int height,
+                                   std::vector<ComponentStats>* stats);
+template int run_length_counter<8>(const std::string& str_matrix, int width, int height,
+                                   std::vector<ComponentStats>* stats);
+template int parallel_counter<4>(const std::string& str_matrix, int width, int height,
+                                 unsigned threads, std::vector<ComponentStats>* stats);
+template int parallel_counter<8>(const std::string& str_matrix, int width, int height,
+                                 unsigned threads, std::vector<ComponentStats>* stats);
+
+// Converte até 64 caracteres '0'/'1' em uma palavra, com o caractere k no
+// bit k. Com SIMD, compara 32 (AVX2) ou 16 (SSE2) caracteres com '1' de uma
+// vez e usa movemask para juntar o resultado em bits.
+
+static std::uint64_t pack_bits(const char* text, std::size_t count) {
+    std::uint64_t word = 0;
+    std::size_t k = 0;
+
+#if defined(__AVX2__)
+    const __m256i one = _mm256_set1_epi8('1');
+    for (; k + 32 <= count; k += 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + k));
+        std::uint64_t mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, one)));
+        word |= mask << k;
+    }
+#endif
+#if defined(__SSE2__)
+    const __m128i one16 = _mm_set1_epi8('1');
+    for (; k + 16 <= count; k += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + k));
+        std::uint64_t mask = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, one16)));
+        word |= mask << k;
+    }
+#endif
+    for (; k < count; k++)
+        word |= std::uint64_t{text[k] == '1'} << k;
+
+    return word;
+}
+
+/// Cria uma imagem de bits de tamanho width * height a partir de uma string binária,
+/// linha a linha, 64 pixels por vez. Pixels além do fim da string ficam em 0.
+BitImage create_image(const std::string& str_matrix, int width, int height) {
+    BitImage image(width, height);
+
+    for (int i = 0; i < height; i++) {
+        std::size_t row = static_cast<std::size_t>(i) * width;
+
+        for (std::size_t w = 0; w < image.stride; w++) {
+            std::size_t first = row + w * 64;
+            std::size_t count = std::min<std::size_t>(64, width - w * 64);
+
+            if (first >= str_matrix.size()) break;
+            count = std::min(count, str_matrix.size() - first);
+
+            image.words[i * image.stride + w] = pack_bits(str_matrix.data() + first, count);
+        }
+    }
+
+    return image;
+}
+
+}
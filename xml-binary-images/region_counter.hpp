@@ -1,11 +1,15 @@
+#ifndef XML_REGION_COUNTER_HPP
+#define XML_REGION_COUNTER_HPP
 
 #include <algorithm>
+#include <cstdint>
 #include <stack>
 #include <string> 
 #include <vector>
 #include <iostream>
 #include <tuple>
 
+#include "array_stack.hpp"
 #include "linked_stack.hpp"
 
 namespace region_counter {
@@ -20,6 +24,32 @@ namespace region_counter {
         WHITE,
     };
 
+    /**
+     * @brief Imagem binária com 1 bit por pixel, em um único vetor. Cada linha
+     * ocupa "stride" palavras de 64 bits; o pixel (i, j) é o bit j % 64 da
+     * palavra i * stride + j / 64. Os bits além de "width" são sempre 0.
+    */
+    struct BitImage {
+        BitImage(int width, int height);
+
+        bool get(int i, int j) const {
+            return (words[i * stride + (j >> 6)] >> (j & 63)) & 1u;
+        }
+
+        void set(int i, int j) {
+            words[i * stride + (j >> 6)] |= std::uint64_t{1} << (j & 63);
+        }
+
+        void reset(int i, int j) {
+            words[i * stride + (j >> 6)] &= ~(std::uint64_t{1} << (j & 63));
+        }
+
+        int width;
+        int height;
+        std::size_t stride;
+        std::vector<std::uint64_t> words;
+    };
+
     /**
 	 * @brief Transforma uma região conexa inteira da matriz em 0's, começando pelo elemento indicado pelas posições (i, j)
      * @param vector<vector<bool>> matriz booleana base
@@ -27,6 +57,30 @@ namespace region_counter {
      * @param int j coordenada j do pixel 
     */
     void clear_region(std::vector<std::vector<bool>>& matrix, int i, int j);
+
+    /**
+     * @brief Estatísticas de uma região conexa: área em pixels, retângulo envolvente (linhas
+     * top a bottom e colunas left a right, inclusive) e centroide (linha e coluna médias).
+    */
+    struct ComponentStats {
+        long long area;
+        int top;
+        int left;
+        int bottom;
+        int right;
+        double row;
+        double col;
+    };
+
+    /**
+	 * @brief Transforma uma região conexa inteira da imagem em 0's, começando pelo pixel (i, j).
+     * CONNECTIVITY é a vizinhança, 4 ou 8, fixada em tempo de compilação
+     * @param BitImage imagem base
+     * @param int i coordenada i do pixel 
+     * @param int j coordenada j do pixel 
+    */
+    template<int CONNECTIVITY = 4>
+    void clear_region(BitImage& image, int i, int j);
     
     /**
 	 * @brief Conta a quantidade de regiões de valor 1 conexas em uma matriz booleana
@@ -34,6 +88,53 @@ namespace region_counter {
     */
     int connectivity_counter(std::vector<std::vector<bool>> matrix);
 
+    /**
+	 * @brief Conta a quantidade de regiões de valor 1 conexas em uma imagem de bits, com
+     * vizinhança CONNECTIVITY (4 ou 8)
+     * @param BitImage imagem a ser utilizada para a contagem
+    */
+    template<int CONNECTIVITY = 4>
+    int connectivity_counter(BitImage image);
+
+    /**
+	 * @brief Rotula as regiões de valor 1 conexas de uma imagem de bits em duas passadas, com
+     * union-find e vizinhança CONNECTIVITY (4 ou 8), e retorna a quantidade de regiões. Os
+     * rótulos são os mesmos da matriz R do README: 1, 2, ... na ordem em que cada região é
+     * encontrada na varredura
+     * @param BitImage imagem a ser rotulada
+     * @param vector<int>* se não for nulo, recebe a matriz R, linha a linha (width * height)
+    */
+    template<int CONNECTIVITY = 4>
+    int label_regions(const BitImage& image, std::vector<int>* labels = nullptr);
+
+    /**
+	 * @brief Conta as regiões de valor 1 conexas direto da string de '0' e '1', sem criar matriz.
+     * Cada linha vira uma lista de sequências (runs) de pixels brancos, e sequências de linhas
+     * vizinhas que se tocam, com vizinhança CONNECTIVITY (4 ou 8), são unidas; o custo depende
+     * da quantidade de sequências
+     * @param string str_matrix matriz codificada em string
+     * @param int width largura da matriz
+     * @param int height altura da matriz
+     * @param vector<ComponentStats>* se não for nulo, recebe as estatísticas de cada região, na
+     * ordem da numeração da matriz R, calculadas na mesma passada
+    */
+    template<int CONNECTIVITY = 4>
+    int run_length_counter(const std::string& str_matrix, int width, int height,
+                           std::vector<ComponentStats>* stats = nullptr);
+
+    /**
+	 * @brief Mesma contagem de run_length_counter, dividindo a matriz em "threads" faixas de
+     * linhas rotuladas em paralelo; as regiões que cruzam as bordas das faixas são unidas no final
+     * @param string str_matrix matriz codificada em string
+     * @param int width largura da matriz
+     * @param int height altura da matriz
+     * @param unsigned threads quantidade de threads (e de faixas)
+     * @param vector<ComponentStats>* se não for nulo, recebe as estatísticas de cada região
+    */
+    template<int CONNECTIVITY = 4>
+    int parallel_counter(const std::string& str_matrix, int width, int height, unsigned threads,
+                         std::vector<ComponentStats>* stats = nullptr);
+
     /** 
 	 * @brief Cria uma matriz booleana a partir de uma string de '0' e '1'.
      * @param string str_matrix matriz codificada em string
@@ -41,4 +142,14 @@ namespace region_counter {
      * @param int height altura da matriz
     */
     std::vector<std::vector<bool>> create_matrix(const std::string& str_matrix, int width, int height);
-}
\ No newline at end of file
+
+    /** 
+	 * @brief Cria uma imagem de bits a partir de uma string de '0' e '1'.
+     * @param string str_matrix matriz codificada em string
+     * @param int width largura da matriz
+     * @param int height altura da matriz
+    */
+    BitImage create_image(const std::string& str_matrix, int width, int height);
+}
+
+#endif
@@ -0,0 +1,194 @@
+#include <algorithm>
+#include <string_view>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "xml_reader.hpp"
+
+namespace xml {
+
+// Compara 32 (AVX2) ou 16 (SSE2) bytes por vez: o bit i da máscara indica
+// se o byte i do bloco é igual a "c". O final é percorrido byte a byte.
+const char* find_char(const char* first, const char* last, char c) {
+#if defined(__AVX2__)
+    const __m256i target = _mm256_set1_epi8(c);
+    while (last - first >= 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+        unsigned mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(block, target));
+        if (mask != 0) return first + __builtin_ctz(mask);
+        first += 32;
+    }
+#elif defined(__SSE2__)
+    const __m128i target = _mm_set1_epi8(c);
+    while (last - first >= 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+        unsigned mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, target));
+        if (mask != 0) return first + __builtin_ctz(mask);
+        first += 16;
+    }
+#endif
+    while (first != last && *first != c) first++;
+
+    return first;
+}
+
+// Nomes dos campos lidos de cada imagem, na ordem de ImageReader::seen_
+static const std::string_view FIELDS[] = {"name", "width", "height", "data"};
+
+ImageReader::ImageReader(std::istream& input):
+    input_{input},
+    buffer_(CHUNK_SIZE),
+    position_{nullptr},
+    end_{nullptr},
+    in_tag_{false},
+    valid_{true},
+    finished_{false},
+    image_{nullptr},
+    complete_{false},
+    image_depth_{0},
+    field_{nullptr},
+    field_depth_{0},
+    seen_{}
+{}
+
+bool ImageReader::next(Image& image) {
+    image_ = &image;
+    complete_ = false;
+
+    while (!complete_ && !finished_) {
+        if (position_ == end_ && !fill()) {
+            finish();
+            break;
+        }
+
+        consume();
+    }
+
+    return complete_;
+}
+
+bool ImageReader::valid() const {
+    return valid_;
+}
+
+// Lê o próximo bloco do arquivo. Retorna false no fim do arquivo
+bool ImageReader::fill() {
+    input_.read(buffer_.data(), buffer_.size());
+    std::size_t count = static_cast<std::size_t>(input_.gcount());
+
+    position_ = buffer_.data();
+    end_ = position_ + count;
+
+    return count > 0;
+}
+
+// Processa o bloco atual até o fim dele ou até uma imagem fechar. Fora de
+// tag, o texto até o próximo '<' vai para o campo sendo lido; dentro, o
+// conteúdo até o '>' é acumulado em tag_, pois pode continuar no próximo bloco
+void ImageReader::consume() {
+    while (position_ != end_ && !complete_ && !finished_) {
+        if (!in_tag_) {
+            const char* start = find_char(position_, end_, '<');
+            text(position_, start);
+            position_ = start;
+
+            if (start != end_) {
+                in_tag_ = true;
+                tag_.clear();
+                position_++;
+            }
+        } else {
+            const char* stop = find_char(position_, end_, '>');
+            tag_.append(position_, stop);
+            position_ = stop;
+
+            if (stop != end_) {
+                in_tag_ = false;
+                position_++;
+
+                if (tag_.empty() || tag_[0] != '/')
+                    open_tag();
+                else
+                    close_tag();
+            }
+        }
+    }
+}
+
+// Guarda o texto no campo sendo lido; de <data> são removidos os '\n'
+void ImageReader::text(const char* first, const char* last) {
+    if (field_ == nullptr) return;
+
+    if (field_ != &image_->data) {
+        field_->append(first, last);
+        return;
+    }
+
+    while (first != last) {
+        const char* line_end = find_char(first, last, '\n');
+        field_->append(first, line_end);
+        first = line_end == last ? last : line_end + 1;
+    }
+}
+
+// Empilha a tag de abertura. Uma <img> começa uma nova imagem e, dentro
+// dela, a primeira ocorrência de cada campo passa a ser lida
+void ImageReader::open_tag() {
+    starts_.push(names_.size());
+    names_ += tag_;
+
+    if (tag_ == "img" && image_depth_ == 0) {
+        image_depth_ = starts_.size();
+        image_->name.clear();
+        image_->width.clear();
+        image_->height.clear();
+        image_->data.clear();
+        std::fill(std::begin(seen_), std::end(seen_), false);
+        return;
+    }
+
+    if (image_depth_ == 0 || field_ != nullptr) return;
+
+    std::string* fields[] = {&image_->name, &image_->width, &image_->height, &image_->data};
+    for (int i = 0; i < 4; i++) {
+        if (!seen_[i] && tag_ == FIELDS[i]) {
+            seen_[i] = true;
+            field_ = fields[i];
+            field_depth_ = starts_.size();
+        }
+    }
+}
+
+// Desempilha a tag de abertura correspondente. Fechar a tag com pilha vazia
+// ou com outro conteúdo no topo é erro de aninhamento
+void ImageReader::close_tag() {
+    std::string_view closing = std::string_view(tag_).substr(1);
+
+    if (starts_.empty() || std::string_view(names_).substr(starts_.top()) != closing) {
+        valid_ = false;
+        finished_ = true;
+        return;
+    }
+
+    names_.resize(starts_.pop());
+
+    if (field_ != nullptr && starts_.size() < field_depth_)
+        field_ = nullptr;
+
+    if (image_depth_ != 0 && starts_.size() < image_depth_) {
+        image_depth_ = 0;
+        complete_ = true;
+    }
+}
+
+// No fim do arquivo não pode haver tag aberta nem tag sem '>'
+void ImageReader::finish() {
+    finished_ = true;
+
+    if (in_tag_ || !starts_.empty())
+        valid_ = false;
+}
+
+}  // namespace xml
@@ -0,0 +1,90 @@
+#ifndef XML_XML_READER_HPP
+#define XML_XML_READER_HPP
+
+#include <cstddef>
+#include <istream>
+#include <string>
+#include <vector>
+
+#include "array_stack.hpp"
+
+namespace xml {
+
+    /**
+     * @brief Retorna a posição da primeira ocorrência de "c" em [first, last),
+     * ou last. Compara 32 (AVX2) ou 16 (SSE2) bytes por vez.
+    */
+    const char* find_char(const char* first, const char* last, char c);
+
+    /**
+     * @brief Campos de uma imagem, como texto. "data" já vem sem os '\n'.
+    */
+    struct Image {
+        std::string name;
+        std::string width;
+        std::string height;
+        std::string data;
+    };
+
+    /**
+     * @brief Leitor de arquivo XML em uma única passada, em blocos de tamanho
+     * fixo. Valida o aninhamento das tags enquanto lê e entrega cada <img>
+     * assim que ela fecha, de modo que a memória usada depende do tamanho de
+     * uma imagem, e não do arquivo inteiro.
+    */
+    class ImageReader {
+     public:
+        explicit ImageReader(std::istream& input);
+
+        /**
+         * @brief Lê até a próxima </img> e preenche "image" com o primeiro
+         * <name>, <width>, <height> e <data> dela. Retorna false no fim do
+         * arquivo ou ao encontrar um erro de aninhamento
+        */
+        bool next(Image& image);
+
+        /**
+         * @brief Indica se o aninhamento das tags está correto até o ponto
+         * lido. Depois que next() retorna false, vale para o arquivo inteiro
+        */
+        bool valid() const;
+
+     private:
+        bool fill();
+        void consume();
+        void text(const char* first, const char* last);
+        void open_tag();
+        void close_tag();
+        void finish();
+
+        static const std::size_t CHUNK_SIZE = 64 * 1024;
+
+        std::istream& input_;
+        std::vector<char> buffer_;
+        const char* position_;
+        const char* end_;
+
+        /// Conteúdo da tag sendo lida, entre '<' e '>'
+        std::string tag_;
+        bool in_tag_;
+        bool valid_;
+        bool finished_;
+
+        /// Conteúdos das tags abertas, concatenados, e onde cada um começa
+        std::string names_;
+        structures::ArrayStack<std::size_t> starts_;
+
+        Image* image_;
+        bool complete_;
+        /// Profundidade da <img> aberta, ou 0 fora de imagem
+        std::size_t image_depth_;
+        /// Campo sendo lido e profundidade da sua tag, ou nullptr
+        std::string* field_;
+        std::size_t field_depth_;
+        /// Campos de name, width, height e data já lidos na imagem atual
+        bool seen_[4];
+    };
+
+}  // namespace xml
+
+#endif